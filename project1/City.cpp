@@ -2,26 +2,77 @@
 #include "Player.h"
 #include "Flatulan.h"
 #include "History.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
 using namespace std;
 
+  // Below this many Flatulans, moveFlatulans uses the simple per-Flatulan
+  // loop; the batch kernel's extra passes only pay off for larger cities
+static const int DEFAULT_BATCH_THRESHOLD = 512;
+
 City::City(int nRows, int nCols)
- : m_rows(nRows), m_cols(nCols), m_player(nullptr), m_nFlatulans(0), m_history(nRows, nCols)
+ : City(nRows, nCols, randomSeed())
+{}
+
+City::City(int nRows, int nCols, uint64_t seed)
+ : m_rows(nRows), m_cols(nCols), m_player(nullptr), m_history(nRows, nCols),
+   m_rng(seed), m_batchThreshold(DEFAULT_BATCH_THRESHOLD)
 {
-    if (nRows <= 0  ||  nCols <= 0  ||  nRows > MAXROWS  ||  nCols > MAXCOLS)
+    size_t cells = cellCount(nRows, nCols);
+    if (cells == 0)
     {
         cout << "***** City created with invalid size " << nRows << " by "
              << nCols << "!" << endl;
         exit(1);
     }
+    m_nAt.assign(cells, 0);
+    m_cellHead.assign(cells, -1);
+}
+
+City::City(const City& other)
+ : m_rows(other.m_rows), m_cols(other.m_cols), m_player(nullptr),
+   m_history(other.m_history), m_rng(other.m_rng),
+   m_flatRows(other.m_flatRows), m_flatCols(other.m_flatCols),
+   m_nAt(other.m_nAt), m_cellHead(other.m_cellHead),
+   m_nextInCell(other.m_nextInCell), m_prevInCell(other.m_prevInCell),
+   m_batchThreshold(other.m_batchThreshold)
+{
+    if (other.m_player != nullptr)
+    {
+        m_player = new Player(*other.m_player);
+        m_player->m_city = this;
+    }
 }
 
 City::~City()
 {
-    for (int k = 0; k < m_nFlatulans; k++)
-        delete m_flatulans[k];
     delete m_player;
 }
 
+City& City::operator=(const City& other)
+{
+    if (this == &other)
+        return *this;
+    City copy(other);
+    std::swap(m_rows, copy.m_rows);
+    std::swap(m_cols, copy.m_cols);
+    std::swap(m_player, copy.m_player);
+    std::swap(m_history, copy.m_history);
+    std::swap(m_rng, copy.m_rng);
+    m_flatRows.swap(copy.m_flatRows);
+    m_flatCols.swap(copy.m_flatCols);
+    m_nAt.swap(copy.m_nAt);
+    m_cellHead.swap(copy.m_cellHead);
+    m_nextInCell.swap(copy.m_nextInCell);
+    m_prevInCell.swap(copy.m_prevInCell);
+    m_batchThreshold = copy.m_batchThreshold;
+    if (m_player != nullptr)
+        m_player->m_city = this;
+    m_renderer.invalidate();
+    return *this;
+}
+
 int City::rows() const
 {
     return m_rows;
@@ -45,19 +96,19 @@ bool City::isPlayerAt(int r, int c) const
 
 int City::flatulanCount() const
 {
-    return m_nFlatulans;
+    return m_flatRows.size();
+}
+
+Flatulan City::flatulan(int k)
+{
+    return Flatulan(this, k);
 }
 
 int City::nFlatulansAt(int r, int c) const
 {
-    int count = 0;
-    for (int k = 0; k < m_nFlatulans; k++)
-    {
-        const Flatulan* fp = m_flatulans[k];
-        if (fp->row() == r  &&  fp->col() == c)
-            count++;
-    }
-    return count;
+    if ( ! isInBounds(r, c))
+        return 0;
+    return m_nAt[cellIndex(r, c)];
 }
 
 bool City::determineNewPosition(int& r, int& c, int dir) const
@@ -76,27 +127,21 @@ bool City::determineNewPosition(int& r, int& c, int dir) const
 void City::display() const
 {
       // Position (row,col) in the city coordinate system is represented in
-      // the array element grid[row-1][col-1]
-    char grid[MAXROWS][MAXCOLS];
-    int r, c;
-    
-        // Fill the grid with dots
-    for (r = 0; r < rows(); r++)
-        for (c = 0; c < cols(); c++)
-            grid[r][c] = '.';
-
-        // Indicate each Flatulan's position
-    for (int k = 0; k < m_nFlatulans; k++)
-    {
-        const Flatulan* fp = m_flatulans[k];
-        char& gridChar = grid[fp->row()-1][fp->col()-1];
-        switch (gridChar)
-        {
-          case '.':  gridChar = 'F'; break;
-          case 'F':  gridChar = '2'; break;
-          case '9':  break;
-          default:   gridChar++; break;  // '2' through '8'
-        }
+      // the array element grid[cellIndex(row,col)]
+    vector<char> grid(m_nAt.size());
+
+        // Indicate the number of Flatulans at each position, or a dot
+    for (size_t k = 0; k < grid.size(); k++)
+    {
+        int n = m_nAt[k];
+        if (n == 0)
+            grid[k] = '.';
+        else if (n == 1)
+            grid[k] = 'F';
+        else if (n >= 9)
+            grid[k] = '9';
+        else
+            grid[k] = '0' + n;  // '2' through '8'
     }
 
         // Indicate player's position
@@ -104,36 +149,41 @@ void City::display() const
     {
           // Set the char to '@', unless there's also a Flatulan there
           // (which should never happen), in which case set it to '*'.
-        char& gridChar = grid[m_player->row()-1][m_player->col()-1];
+        char& gridChar = grid[cellIndex(m_player->row(), m_player->col())];
         if (gridChar == '.')
             gridChar = '@';
         else
             gridChar = '*';
     }
 
-        // Draw the grid
-    clearScreen();
-    for (r = 0; r < rows(); r++)
-    {
-        for (c = 0; c < cols(); c++)
-            cout << grid[r][c];
-        cout << endl;
-    }
-    cout << endl;
-
         // Write message, Flatulan, and player info
-    cout << "There are " << m_nFlatulans << " unconverted Flatulans remaining." << endl;
+    string status = "There are " + to_string(flatulanCount()) +
+                    " unconverted Flatulans remaining.\n";
     if (m_player == nullptr)
-        cout << "There is no player." << endl;
+        status += "There is no player.\n";
     else
     {
         if (m_player->age() > 0)
-            cout << "The player has lasted " << m_player->age() << " steps." << endl;
+            status += "The player has lasted " + to_string(m_player->age()) + " steps.\n";
         if (m_player->isPassedOut())
-            cout << "The player has passed out." << endl;
+            status += "The player has passed out.\n";
         else
-            cout << "The player's health level is " << m_player->health() << endl;
+            status += "The player's health level is " + to_string(m_player->health()) + "\n";
     }
+
+        // Draw the grid and the status; the renderer only rewrites what
+        // changed since the last call
+    m_renderer.draw(grid, rows(), cols(), status);
+}
+
+void City::invalidateDisplay()
+{
+    m_renderer.invalidate();
+}
+
+void City::setMaxFrameRate(double framesPerSecond)
+{
+    m_renderer.setMaxFrameRate(framesPerSecond);
 }
 
 bool City::addFlatulan(int r, int c)
@@ -145,14 +195,24 @@ bool City::addFlatulan(int r, int c)
     if (m_player != nullptr  &&  m_player->row() == r  &&  m_player->col() == c)
         return false;
 
-      // Dynamically allocate a new Flatulan and add it to the city
-    if (m_nFlatulans == MAXFLATULANS)
-        return false;
-    m_flatulans[m_nFlatulans] = new Flatulan(this, r, c);
-    m_nFlatulans++;
+      // Add the new Flatulan's position to the end of the arrays
+    m_flatRows.push_back(r);
+    m_flatCols.push_back(c);
+    m_nextInCell.push_back(-1);
+    m_prevInCell.push_back(-1);
+    m_nAt[cellIndex(r, c)]++;
+    linkToCell(flatulanCount() - 1);
     return true;
 }
 
+void City::reserveFlatulans(int n)
+{
+    m_flatRows.reserve(n);
+    m_flatCols.reserve(n);
+    m_nextInCell.reserve(n);
+    m_prevInCell.reserve(n);
+}
+
 bool City::addPlayer(int r, int c)
 {
     if ( ! isInBounds(r, c))
@@ -173,40 +233,43 @@ bool City::addPlayer(int r, int c)
 
 void City::preachToFlatulansAroundPlayer()
 {
-      // Preach to Flatulans orthogonally or diagonally adjacent to player.  If a
-      // Flatulan is converted, then since the order of the Flatulans in the array
-      // doesn't matter, we can replace the converted Flatulan we remove from the
-      // game by the last one in the array.
+      // Preach to Flatulans orthogonally or diagonally adjacent to player.
+      // Only the Flatulans on the nine cells around the player are looked at,
+      // found through the per-cell lists, so the cost doesn't depend on how
+      // many Flatulans there are elsewhere in the city.
     if (m_player == nullptr)
         return;
 
+    vector<int>& nearby = m_nearby;
+    nearby.clear();
+    for (int r = m_player->row() - 1; r <= m_player->row() + 1; r++)
+        for (int c = m_player->col() - 1; c <= m_player->col() + 1; c++)
+        {
+            if ( ! isInBounds(r, c))
+                continue;
+            for (int k = m_cellHead[cellIndex(r, c)]; k != -1; k = m_nextInCell[k])
+                nearby.push_back(k);
+        }
+
+      // Each one is converted with 2/3 probability
+    m_rng.fill(m_rolls, nearby.size(), 0, 2);
     bool failed = false;
-    for (int k = 0; k < m_nFlatulans; )
-    {
-        Flatulan* fp = m_flatulans[k];
-        int rowdiff = fp->row() - m_player->row();
-        int coldiff = fp->col() - m_player->col();
-
-          // if orthogonally or diagonally adjacent and conversion succeeds
-        bool convertRoll = fp->possiblyGetConverted(); 
-        if (rowdiff >= -1  &&  rowdiff <= 1  &&
-            coldiff >= -1  &&  coldiff <= 1 )
-            {
-                if(convertRoll)
-                {
-                    delete m_flatulans[k];
-                    m_flatulans[k] = m_flatulans[m_nFlatulans-1];
-                    m_nFlatulans--;
-                }
-                else
-                {
-                    failed = true;
-                    k++;
-                }
-            }
+    size_t nConverted = 0;
+    for (size_t i = 0; i < nearby.size(); i++)
+    {
+        if (m_rolls[i] < 2)
+            nearby[nConverted++] = nearby[i];
         else
-            k++;
+            failed = true;
     }
+
+      // Removing a Flatulan moves the last one in the arrays into its slot,
+      // so remove the converted ones from the highest index down; that way
+      // none of the ones still to be removed gets moved.
+    sort(nearby.begin(), nearby.begin() + nConverted, greater<int>());
+    for (size_t i = 0; i < nConverted; i++)
+        removeFlatulan(nearby[i]);
+
     if(failed)
     {
         m_history.record(m_player->row(), m_player->col());
@@ -215,14 +278,20 @@ void City::preachToFlatulansAroundPlayer()
 
 void City::moveFlatulans()
 {
-    for (int k = 0; k < m_nFlatulans; k++)
+    const int n = flatulanCount();
+    m_rng.fill(m_rolls, n, 0, NUMDIRS-1);  // a direction for each Flatulan
+    if (n >= m_batchThreshold)
     {
-        Flatulan* fp = m_flatulans[k];
-        fp->move();
+        moveFlatulansBatch();
+        return;
+    }
+    for (int k = 0; k < n; k++)
+    {
+        moveFlatulan(k, m_rolls[k]);
         if (m_player == nullptr)
             continue;
-        int rowdiff = fp->row() - m_player->row();
-        int coldiff = fp->col() - m_player->col();
+        int rowdiff = m_flatRows[k] - m_player->row();
+        int coldiff = m_flatCols[k] - m_player->col();
           // if orthogonally adjacent
         if  ((rowdiff == 0  &&  (coldiff == 1  ||  coldiff == -1))  ||
              (coldiff == 0  &&  (rowdiff == 1  ||  rowdiff == -1)) )
@@ -230,12 +299,301 @@ void City::moveFlatulans()
     }
 }
 
+void City::setBatchThreshold(int n)
+{
+    m_batchThreshold = n;
+}
+
+void City::moveFlatulansBatch()
+{
+      // Same result as the loop in moveFlatulans, given the same directions in
+      // m_rolls.  The player doesn't move during this pass, so each Flatulan's
+      // new position and whether it gasses the player are independent of the
+      // others.  The first loop computes them without branches so the compiler
+      // can vectorize it; the second updates the per-cell counts and lists.
+    const int n = flatulanCount();
+    const int nRows = m_rows;
+    const int nCols = m_cols;
+    const int pr = m_player != nullptr ? m_player->row() : 0;
+    const int pc = m_player != nullptr ? m_player->col() : 0;
+    m_newRows.resize(n);
+    m_newCols.resize(n);
+    const int* dirs = m_rolls.data();
+    const int* oldRows = m_flatRows.data();
+    const int* oldCols = m_flatCols.data();
+    int* newRows = m_newRows.data();
+    int* newCols = m_newCols.data();
+
+    int hits = 0;
+    for (int k = 0; k < n; k++)
+    {
+        int d = dirs[k];
+        int r = oldRows[k] + (d == DOWN) - (d == UP);
+        int c = oldCols[k] + (d == RIGHT) - (d == LEFT);
+        bool ok = r >= 1  &&  r <= nRows  &&  c >= 1  &&  c <= nCols  &&
+                  ! (r == pr  &&  c == pc);
+        r = ok ? r : oldRows[k];
+        c = ok ? c : oldCols[k];
+        newRows[k] = r;
+        newCols[k] = c;
+          // orthogonally adjacent to the player
+        int rowdist = r > pr ? r - pr : pr - r;
+        int coldist = c > pc ? c - pc : pc - c;
+        hits += (rowdist + coldist == 1);
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        if (newRows[k] != oldRows[k]  ||  newCols[k] != oldCols[k])
+        {
+            unlinkFromCell(k);
+            m_nAt[cellIndex(oldRows[k], oldCols[k])]--;
+            m_nAt[cellIndex(newRows[k], newCols[k])]++;
+            m_flatRows[k] = newRows[k];
+            m_flatCols[k] = newCols[k];
+            linkToCell(k);
+        }
+    }
+
+    if (m_player != nullptr)
+        for ( ; hits > 0; hits--)
+            m_player->getGassed();
+}
+
 bool City::isInBounds(int r, int c) const
 {
     return (r >= 1  &&  r <= m_rows  &&  c >= 1  &&  c <= m_cols);
 }
 
+size_t City::cellIndex(int r, int c) const
+{
+    return size_t(r-1) * m_cols + (c-1);
+}
+
+void City::moveFlatulan(int k, int dir)
+{
+      // Attempt to move in direction dir; if it can't move, don't move.
+      // If the player is there, don't move.  A Flatulan that stays put keeps
+      // its place in its cell's list, as in moveFlatulansBatch, so preaching
+      // sees the same order whichever way the Flatulans were moved.
+    int r = m_flatRows[k];
+    int c = m_flatCols[k];
+    determineNewPosition(r, c, dir);
+    if ((r != m_flatRows[k]  ||  c != m_flatCols[k])  &&  ! isPlayerAt(r, c))
+    {
+        unlinkFromCell(k);
+        m_nAt[cellIndex(m_flatRows[k], m_flatCols[k])]--;
+        m_nAt[cellIndex(r, c)]++;
+        m_flatRows[k] = r;
+        m_flatCols[k] = c;
+        linkToCell(k);
+    }
+}
+
+void City::removeFlatulan(int k)
+{
+      // Since the order of the Flatulans doesn't matter, move the last one
+      // into the removed one's slot
+    int last = flatulanCount() - 1;
+    m_nAt[cellIndex(m_flatRows[k], m_flatCols[k])]--;
+    unlinkFromCell(k);
+    if (k != last)
+    {
+        unlinkFromCell(last);
+        m_flatRows[k] = m_flatRows[last];
+        m_flatCols[k] = m_flatCols[last];
+        linkToCell(k);
+    }
+    m_flatRows.pop_back();
+    m_flatCols.pop_back();
+    m_nextInCell.pop_back();
+    m_prevInCell.pop_back();
+}
+
+void City::linkToCell(int k)
+{
+      // Push Flatulan k onto the front of the list for its current position
+    int& head = m_cellHead[cellIndex(m_flatRows[k], m_flatCols[k])];
+    m_prevInCell[k] = -1;
+    m_nextInCell[k] = head;
+    if (head != -1)
+        m_prevInCell[head] = k;
+    head = k;
+}
+
+void City::unlinkFromCell(int k)
+{
+      // Remove Flatulan k from the list for its current position
+    int prev = m_prevInCell[k];
+    int next = m_nextInCell[k];
+    if (prev != -1)
+        m_nextInCell[prev] = next;
+    else
+        m_cellHead[cellIndex(m_flatRows[k], m_flatCols[k])] = next;
+    if (next != -1)
+        m_prevInCell[next] = prev;
+}
+
 History& City::history()
 {
     return m_history;
-}
\ No newline at end of file
+}
+
+Rng& City::rng()
+{
+    return m_rng;
+}
+
+  // A snapshot holds, in this machine's byte order:
+  //   "FCS1"
+  //   rows, cols, number of Flatulans, whether there's a player, and the
+  //     player's row, col, health, and age (8 ints)
+  //   the generator state (4 64-bit ints)
+  //   the Flatulan rows, cols, and per-cell list links (4 arrays of ints)
+  //   the per-cell counts and list heads (2 arrays of ints)
+  //   the History counts (an array of 32-bit unsigned ints)
+  // Everything but the header is a straight copy of City's arrays, so saving
+  // and restoring cost about as much as a memcpy of the state.
+static const char SNAPSHOT_MAGIC[4] = { 'F', 'C', 'S', '1' };
+static const int  SNAPSHOT_HEADER_INTS = 8;
+
+namespace
+{
+    template <typename T>
+    void append(vector<char>& out, const T* data, size_t n)
+    {
+        const char* bytes = reinterpret_cast<const char*>(data);
+        out.insert(out.end(), bytes, bytes + n * sizeof(T));
+    }
+
+    template <typename T>
+    void extract(const char*& in, vector<T>& data, size_t n)
+    {
+        data.resize(n);
+        if (n > 0)
+            memcpy(data.data(), in, n * sizeof(T));
+        in += n * sizeof(T);
+    }
+}
+
+void City::saveSnapshot(vector<char>& out) const
+{
+    size_t n = m_flatRows.size();
+    size_t cells = m_nAt.size();
+    int header[SNAPSHOT_HEADER_INTS] = {
+        m_rows, m_cols, int(n), m_player != nullptr,
+        m_player != nullptr ? m_player->row() : 0,
+        m_player != nullptr ? m_player->col() : 0,
+        m_player != nullptr ? m_player->health() : 0,
+        m_player != nullptr ? m_player->age() : 0
+    };
+    uint64_t rngState[4];
+    m_rng.getState(rngState);
+
+    out.clear();
+    out.reserve(sizeof(SNAPSHOT_MAGIC) + sizeof(header) + sizeof(rngState) +
+                4 * n * sizeof(int) + 2 * cells * sizeof(int) +
+                cells * sizeof(uint32_t));
+    append(out, SNAPSHOT_MAGIC, 4);
+    append(out, header, SNAPSHOT_HEADER_INTS);
+    append(out, rngState, 4);
+    append(out, m_flatRows.data(), n);
+    append(out, m_flatCols.data(), n);
+    append(out, m_nextInCell.data(), n);
+    append(out, m_prevInCell.data(), n);
+    append(out, m_nAt.data(), cells);
+    append(out, m_cellHead.data(), cells);
+    append(out, m_history.counts.data(), cells);
+}
+
+bool City::restoreSnapshot(const vector<char>& in)
+{
+      // Check the header and the total size, then read everything into
+      // scratch arrays and check those, before changing anything
+    const size_t fixedSize = sizeof(SNAPSHOT_MAGIC) +
+                             SNAPSHOT_HEADER_INTS * sizeof(int) + 4 * sizeof(uint64_t);
+    if (in.size() < fixedSize  ||  memcmp(in.data(), SNAPSHOT_MAGIC, 4) != 0)
+        return false;
+    int header[SNAPSHOT_HEADER_INTS];
+    memcpy(header, in.data() + 4, sizeof(header));
+    int nRows = header[0], nCols = header[1], n = header[2];
+    size_t cells = cellCount(nRows, nCols);
+    size_t rest = in.size() - fixedSize;
+    if (cells == 0  ||  n < 0  ||  size_t(n) > rest / (4 * sizeof(int))  ||
+        rest != 4 * size_t(n) * sizeof(int) +
+                2 * cells * sizeof(int) + cells * sizeof(uint32_t))
+        return false;
+    bool hasPlayer = header[3] != 0;
+    if (header[3] != 0  &&  header[3] != 1)
+        return false;
+    if (hasPlayer  &&  (header[4] < 1  ||  header[4] > nRows  ||
+                        header[5] < 1  ||  header[5] > nCols  ||
+                        header[6] > INITIAL_PLAYER_HEALTH  ||  header[7] < 0))
+        return false;
+
+    const char* p = in.data() + 4 + sizeof(header);
+    uint64_t rngState[4];
+    memcpy(rngState, p, sizeof(rngState));
+    p += sizeof(rngState);
+    vector<int> flatRows, flatCols, nextInCell, prevInCell, nAt, cellHead;
+    vector<uint32_t> counts;
+    extract(p, flatRows, n);
+    extract(p, flatCols, n);
+    extract(p, nextInCell, n);
+    extract(p, prevInCell, n);
+    extract(p, nAt, cells);
+    extract(p, cellHead, cells);
+    extract(p, counts, cells);
+
+      // Every Flatulan must be in bounds and on exactly the list for its
+      // position, linked both ways, and the counts must match the lists
+    for (int k = 0; k < n; k++)
+        if (flatRows[k] < 1  ||  flatRows[k] > nRows  ||
+            flatCols[k] < 1  ||  flatCols[k] > nCols)
+            return false;
+    int listed = 0;
+    for (size_t cell = 0; cell < cells; cell++)
+    {
+        int prev = -1;
+        int inCell = 0;
+        for (int k = cellHead[cell]; k != -1; k = nextInCell[k])
+        {
+            if (k < 0  ||  k >= n  ||  inCell == n  ||  prevInCell[k] != prev  ||
+                size_t(flatRows[k] - 1) * nCols + (flatCols[k] - 1) != cell)
+                return false;
+            prev = k;
+            inCell++;
+        }
+        if (inCell != nAt[cell])
+            return false;
+        listed += inCell;
+    }
+    if (listed != n)
+        return false;
+
+    m_rng.setState(rngState);
+    if (nRows != m_rows  ||  nCols != m_cols)
+    {
+        m_rows = nRows;
+        m_cols = nCols;
+        m_history = History(nRows, nCols);
+    }
+    m_flatRows.swap(flatRows);
+    m_flatCols.swap(flatCols);
+    m_nextInCell.swap(nextInCell);
+    m_prevInCell.swap(prevInCell);
+    m_nAt.swap(nAt);
+    m_cellHead.swap(cellHead);
+    m_history.counts.swap(counts);
+
+    delete m_player;
+    m_player = nullptr;
+    if (hasPlayer)
+    {
+        m_player = new Player(this, header[4], header[5]);
+        m_player->m_health = header[6];
+        m_player->m_age = header[7];
+    }
+    m_renderer.invalidate();
+    return true;
+}
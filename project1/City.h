@@ -3,13 +3,19 @@
 
 #include "globals.h"
 #include "History.h"
+#include "Rng.h"
+#include "Renderer.h"
+#include <vector>
 
 class City
 {
   public:
         // Constructor/destructor
     City(int nRows, int nCols);
+    City(int nRows, int nCols, std::uint64_t seed);
+    City(const City& other);
     ~City();
+    City& operator=(const City& other);
 
         // Accessors
     int     rows() const;
@@ -17,27 +23,70 @@ class City
     Player* player() const;
     bool    isPlayerAt(int r, int c) const;
     int     flatulanCount() const;
+    Flatulan flatulan(int k);
     int     nFlatulansAt(int r, int c) const;
     bool    determineNewPosition(int& r, int& c, int dir) const;
     void    display() const;
     History& history();
+    Rng&    rng();
+    void    saveSnapshot(std::vector<char>& out) const;
 
         // Mutators
     bool  addFlatulan(int r, int c);
+    void  reserveFlatulans(int n);
     bool  addPlayer(int r, int c);
     void  preachToFlatulansAroundPlayer();
     void  moveFlatulans();
+    void  setBatchThreshold(int n);
+    void  invalidateDisplay();
+    void  setMaxFrameRate(double framesPerSecond);
+    bool  restoreSnapshot(const std::vector<char>& in);
 
   private:
+    friend class Flatulan;
+
     int       m_rows;
     int       m_cols;
     Player*   m_player;
-    Flatulan* m_flatulans[MAXFLATULANS];
-    int       m_nFlatulans;
     History   m_history;
+    Rng       m_rng;     // every random choice in the city comes from here
+    mutable Renderer m_renderer;  // remembers what display() last drew
+
+      // The kth Flatulan is at (m_flatRows[k], m_flatCols[k]).  Keeping the
+      // positions in two parallel arrays lets the per-turn passes walk
+      // contiguous memory; a Flatulan object is just a view of one index.
+    std::vector<int> m_flatRows;
+    std::vector<int> m_flatCols;
+
+      // Number of Flatulans at each position, kept up to date as Flatulans
+      // are added, move, and get converted, so lookups don't scan the array.
+      // Position (row,col) is stored at index cellIndex(row,col).
+    std::vector<int> m_nAt;
+
+      // The Flatulans at each position form a doubly-linked list threaded
+      // through m_nextInCell/m_prevInCell (indexed like m_flatRows), whose
+      // first element is m_cellHead[cellIndex(row,col)], or -1 if none.
+    std::vector<int> m_cellHead;
+    std::vector<int> m_nextInCell;
+    std::vector<int> m_prevInCell;
+
+      // Scratch space for one turn's worth of random rolls, the Flatulans
+      // being preached to, and, when there are at least m_batchThreshold
+      // Flatulans, their new positions
+    std::vector<int> m_rolls;
+    std::vector<int> m_nearby;
+    std::vector<int> m_newRows;
+    std::vector<int> m_newCols;
+    int       m_batchThreshold;
 
       // Helper functions
     bool isInBounds(int r, int c) const;
+    std::size_t cellIndex(int r, int c) const;
+    void moveFlatulan(int k, int dir);
+    void moveFlatulansBatch();
+    void removeFlatulan(int k);
+    void linkToCell(int k);
+    void unlinkFromCell(int k);
 };
 
 #endif
\ No newline at end of file
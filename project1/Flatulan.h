@@ -3,24 +3,22 @@
 
 #include "globals.h"
 
+  // A Flatulan is a lightweight, read-only view of one entry in its City's
+  // position arrays; it doesn't own any storage of its own.  Flatulans are
+  // moved and converted by City, a whole turn's worth at a time.
 class Flatulan
 {
   public:
         // Constructor
-    Flatulan(City* cp, int r, int c);
+    Flatulan(City* cp, int k);
 
         // Accessors
     int  row() const;
     int  col() const;
 
-        // Mutators
-    void move();
-    bool possiblyGetConverted();
-
   private:
     City* m_city;
-    int   m_row;
-    int   m_col;
+    int   m_index;
 };
 
 #endif
\ No newline at end of file
@@ -2,40 +2,42 @@
 #include "City.h"
 #include "Player.h"
 #include "History.h"
+#include <fstream>
 using namespace std;
 
 Game::Game(int rows, int cols, int nFlatulans)
+ : Game(rows, cols, nFlatulans, randomSeed())
+{}
+
+Game::Game(int rows, int cols, int nFlatulans, uint64_t seed)
+ : m_rows(rows), m_cols(cols), m_nFlatulans(nFlatulans), m_seed(seed)
 {
     if (nFlatulans < 0)
     {
         cout << "***** Cannot create Game with negative number of Flatulans!" << endl;
         exit(1);
     }
-    if (nFlatulans > MAXFLATULANS)
-    {
-        cout << "***** Trying to create Game with " << nFlatulans
-             << " Flatulans; only " << MAXFLATULANS << " are allowed!" << endl;
-        exit(1);
-    }
     if (rows == 1  &&  cols == 1  &&  nFlatulans > 0)
     {
         cout << "***** Cannot create Game with nowhere to place the Flatulans!" << endl;
         exit(1);
     }
 
-        // Create city
-    m_city = new City(rows, cols);
+        // Create city; the same seed always sets up and plays out the same way
+    m_city = new City(rows, cols, seed);
+    Rng& rng = m_city->rng();
 
         // Add player
-    int rPlayer = randInt(1, rows);
-    int cPlayer = randInt(1, cols);
+    int rPlayer = rng.randInt(1, rows);
+    int cPlayer = rng.randInt(1, cols);
     m_city->addPlayer(rPlayer, cPlayer);
 
       // Populate with Flatulans
+    m_city->reserveFlatulans(nFlatulans);
     while (nFlatulans > 0)
     {
-        int r = randInt(1, rows);
-        int c = randInt(1, cols);
+        int r = rng.randInt(1, rows);
+        int c = rng.randInt(1, cols);
           // Don't put a Flatulan where the player is
         if (r == rPlayer  &&  c == cPlayer)
             continue;
@@ -49,6 +51,27 @@ Game::~Game()
     delete m_city;
 }
 
+City* Game::city() const
+{
+    return m_city;
+}
+
+const string& Game::moveLog() const
+{
+    return m_moveLog;
+}
+
+bool Game::saveMoveLog(const string& filename) const
+{
+      // First line: rows cols nFlatulans seed; second line: the actions
+    ofstream out(filename);
+    if ( ! out)
+        return false;
+    out << m_rows << " " << m_cols << " " << m_nFlatulans << " " << m_seed << "\n"
+        << m_moveLog << "\n";
+    return bool(out);
+}
+
 void Game::play()
 {
     m_city->display();
@@ -63,7 +86,10 @@ void Game::play()
         getline(cin,action);
         bool state = true;
         if (action.size() == 0)  // player preaches
+        {
             p->preach();
+            m_moveLog += 'p';
+        }
         else
         {
             switch (action[0])
@@ -78,6 +104,7 @@ void Game::play()
               case 'l':
               case 'r':
                 p->move(decodeDirection(action[0]));
+                m_moveLog += action[0];
                 break;
               case 'h':
                 m_city->history().display();
@@ -85,6 +112,8 @@ void Game::play()
                 cin.ignore(10000,'\n');
                 state = false;
                 clearScreen();
+                m_city->history().invalidateDisplay();
+                m_city->invalidateDisplay();
             }
         }
         if (state)
@@ -97,4 +126,83 @@ void Game::play()
         cout << "You lose." << endl;
     else
         cout << "You win." << endl;
+}
+
+GameResult Game::playHeadless(const PlayerPolicy& policy, int maxTurns)
+{
+      // Same rules as play(), but nothing is read from cin or written to cout
+    GameResult result;
+    result.turns = 0;
+    Player* p = m_city->player();
+    for (int attempts = 0; attempts < maxTurns; attempts++)
+    {
+        if (p == nullptr  ||  p->isPassedOut()  ||  m_city->flatulanCount() == 0)
+            break;
+        char action = policy(*m_city);
+        if (action == 'q')
+            break;
+        if ( ! takeTurn(action))
+            continue;  // a bad move is ignored, as in play()
+        result.turns++;
+        result.healthByTurn.push_back(p->health());
+    }
+    result.passedOut = p != nullptr  &&  p->isPassedOut();
+    result.won = ! result.passedOut  &&  m_city->flatulanCount() == 0;
+    return result;
+}
+
+GameResult Game::playHeadless(const string& script)
+{
+      // Take the actions in script in order; the game ends early if the
+      // script runs out
+    size_t next = 0;
+    auto fromScript = [&script, &next](const City&) {
+        return next < script.size() ? script[next++] : 'q';
+    };
+    return playHeadless(fromScript, script.size());
+}
+
+bool Game::takeTurn(char action)
+{
+    if ( ! playTurn(*m_city, action))
+        return false;
+    m_moveLog += action;
+    return true;
+}
+
+bool playTurn(City& city, char action)
+{
+    Player* p = city.player();
+    switch (action)
+    {
+      case 'p':
+        p->preach();
+        break;
+      case 'u':
+      case 'd':
+      case 'l':
+      case 'r':
+        p->move(decodeDirection(action));
+        break;
+      default:   // if bad move, nobody moves
+        return false;
+    }
+    city.moveFlatulans();
+    return true;
+}
+
+bool replayGame(const string& filename, GameResult& result)
+{
+    ifstream in(filename);
+    int rows, cols, nFlatulans;
+    uint64_t seed;
+    if ( ! (in >> rows >> cols >> nFlatulans >> seed))
+        return false;
+    string moves;
+    in >> moves;  // empty if no turns were taken
+    if (rows <= 0  ||  cols <= 0  ||  nFlatulans < 0)
+        return false;
+    Game g(rows, cols, nFlatulans, seed);
+    result = g.playHeadless(moves);
+    return true;
 }
\ No newline at end of file
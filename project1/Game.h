@@ -2,19 +2,64 @@
 #define GAME
 
 #include "globals.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+  // Outcome of a game played without a human at the keyboard
+struct GameResult
+{
+    bool won;                       // all Flatulans were converted
+    bool passedOut;                 // the player's health reached 0
+    int  turns;                     // number of turns the player took
+    std::vector<int> healthByTurn;  // player's health after each turn
+};
+
+  // Chooses the player's next action given the current state of the city:
+  // 'u', 'd', 'l', or 'r' to move, 'p' to preach, or 'q' to quit
+using PlayerPolicy = std::function<char(const City&)>;
 
 class Game
 {
   public:
         // Constructor/destructor
     Game(int rows, int cols, int nFlatulans);
+    Game(int rows, int cols, int nFlatulans, std::uint64_t seed);
     ~Game();
 
+        // Accessors
+    City* city() const;
+    const std::string& moveLog() const;
+    bool  saveMoveLog(const std::string& filename) const;
+
         // Mutators
     void play();
+    GameResult playHeadless(const PlayerPolicy& policy, int maxTurns);
+    GameResult playHeadless(const std::string& script);
 
   private:
     City* m_city;
+
+      // Everything needed to replay this game: how it was set up, and every
+      // action that took a turn ('u', 'd', 'l', 'r', or 'p'), in order
+    int           m_rows;
+    int           m_cols;
+    int           m_nFlatulans;
+    std::uint64_t m_seed;
+    std::string   m_moveLog;
+
+      // Helper functions
+    bool takeTurn(char action);
 };
 
+  // Take one turn in city: the player does action ('u', 'd', 'l', or 'r' to
+  // move, 'p' to preach), then the Flatulans move.  Return false, changing
+  // nothing, if action doesn't take a turn.  Game and anything simulating it
+  // play by these rules.
+bool playTurn(City& city, char action);
+
+  // Replay a game saved by Game::saveMoveLog without displaying anything.
+  // Return false if the file can't be read.
+bool replayGame(const std::string& filename, GameResult& result);
+
 #endif
\ No newline at end of file
@@ -1,17 +1,33 @@
 #include "History.h"
+#include <fstream>
 using namespace std;
 
 History::History(int nRows, int nCols)
 {
-    m_rows = nRows;
-    m_cols = nCols;
-    for(int i = 0; i < nRows; i++)
+    // A size with no valid positions (or too many) records nothing
+    size_t cells = cellCount(nRows, nCols);
+    m_rows = (cells == 0 ? 0 : nRows);
+    m_cols = (cells == 0 ? 0 : nCols);
+    counts.assign(cells, 0);
+}
+
+int History::rows() const
+{
+    return m_rows;
+}
+
+int History::cols() const
+{
+    return m_cols;
+}
+
+int History::count(int r, int c) const
+{
+    if(r < 1 || r > m_rows || c < 1 || c > m_cols)
     {
-        for(int j = 0; j < nCols; j++)
-        {
-            grid[i][j] = '.';
-        }
+        return 0;
     }
+    return counts[size_t(r-1) * m_cols + (c-1)];
 }
 
 bool History::record(int r, int c)
@@ -20,29 +36,106 @@ bool History::record(int r, int c)
     {
         return false;
     }
-    if(grid[r-1][c-1] == '.')
+    size_t k = size_t(r-1) * m_cols + (c-1);
+    if(counts[k] < UINT32_MAX)
     {
-        grid[r-1][c-1] = 'A';
+        counts[k]++;
     }
-    else if(grid[r-1][c-1] >= 65 && grid[r-1][c-1] <= 89)
+    return true;
+}
+
+bool History::merge(const History& other)
+{
+    // Add other's count at each position to ours
+    if(other.m_rows != m_rows || other.m_cols != m_cols)
     {
-        grid[r-1][c-1] += 1;
+        return false;
     }
-    else if(grid[r-1][c-1] == 90)
+    for(size_t k = 0; k < counts.size(); k++)
     {
-        grid[r-1][c-1] = 'Z';
+        uint64_t n = uint64_t(counts[k]) + other.counts[k];
+        counts[k] = (n > UINT32_MAX ? UINT32_MAX : uint32_t(n));
     }
     return true;
 }
 
+bool History::exportCsv(const string& filename) const
+{
+    // One line per row, with the counts separated by commas
+    ofstream out(filename);
+    if(!out)
+    {
+        return false;
+    }
+    string line;
+    for(int r = 0; r < m_rows; r++)
+    {
+        line.clear();
+        for(int c = 0; c < m_cols; c++)
+        {
+            if(c > 0)
+            {
+                line += ',';
+            }
+            line += to_string(counts[size_t(r) * m_cols + c]);
+        }
+        line += '\n';
+        out << line;
+    }
+    return bool(out);
+}
+
+bool History::exportBinary(const string& filename) const
+{
+    // "FHST", then rows, cols, and every count in row-major order, each as a
+    // little-endian 32-bit unsigned int
+    ofstream out(filename, ios::binary);
+    if(!out)
+    {
+        return false;
+    }
+    vector<unsigned char> bytes(4 * (2 + counts.size()));
+    auto put = [&bytes](size_t k, uint32_t v) {
+        bytes[4*k] = v & 0xFF;
+        bytes[4*k + 1] = (v >> 8) & 0xFF;
+        bytes[4*k + 2] = (v >> 16) & 0xFF;
+        bytes[4*k + 3] = (v >> 24) & 0xFF;
+    };
+    put(0, m_rows);
+    put(1, m_cols);
+    for(size_t k = 0; k < counts.size(); k++)
+    {
+        put(k + 2, counts[k]);
+    }
+    out.write("FHST", 4);
+    out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    return bool(out);
+}
+
+char History::displayChar(size_t k) const
+{
+    // '.' if never recorded, 'A' through 'Y' for 1 through 25, else 'Z'
+    uint32_t n = counts[k];
+    if(n == 0)
+    {
+        return '.';
+    }
+    return (n >= 26 ? 'Z' : 'A' + n - 1);
+}
+
 void History::display() const
 {
-    clearScreen();
-    for (int r = 0; r < m_rows; r++)
+    // The renderer writes the whole grid the first time and only the
+    // positions that changed after that, in one write either way
+    vector<char> grid(counts.size());
+    for(size_t k = 0; k < counts.size(); k++)
     {
-        for (int c = 0; c < m_cols; c++)
-            cout << grid[r][c];
-        cout << endl;
+        grid[k] = displayChar(k);
     }
-    cout << endl;
+    renderer.draw(grid, m_rows, m_cols, "");
+}
+
+void History::invalidateDisplay()
+{
+    renderer.invalidate();
 }
\ No newline at end of file
@@ -2,18 +2,34 @@
 #define HISTORY
 
 #include "globals.h"
+#include "Renderer.h"
+#include <cstdint>
+#include <vector>
 
 class History
 {
     public:
         History(int nRows, int nCols);
+        int  rows() const;
+        int  cols() const;
+        int  count(int r, int c) const;
         bool record(int r, int c);
+        bool merge(const History& other);
+        bool exportCsv(const std::string& filename) const;
+        bool exportBinary(const std::string& filename) const;
         void display() const;
+        void invalidateDisplay();
     
     private:
+        friend class City;  // to save and restore snapshots
         int m_rows;
         int m_cols;
-        char grid[MAXROWS][MAXCOLS];
+        // Exact count for (r,c) is at counts[(r-1)*m_cols + c-1]
+        std::vector<std::uint32_t> counts;
+        // Remembers what display() last drew, so the next one only
+        // rewrites the positions whose character has changed
+        mutable Renderer renderer;
+        char displayChar(std::size_t k) const;
 };
 
 #endif
\ No newline at end of file
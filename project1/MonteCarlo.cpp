@@ -0,0 +1,99 @@
+#include "MonteCarlo.h"
+#include "City.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+MonteCarloResult::MonteCarloResult(int rows, int cols)
+ : games(0), wins(0), totalTurns(0), winRate(0), meanTurns(0), seconds(0),
+   heatmap(rows, cols)
+{}
+
+namespace
+{
+      // Games [next, end) still waiting to be run.  The owning thread takes
+      // games from here first; idle threads steal from other threads' ranges.
+    struct WorkRange
+    {
+        atomic<int> next;
+        int         end;
+    };
+
+      // Return the index of an unclaimed game, or -1 if all have been claimed
+    int claimGame(WorkRange* ranges, int nThreads, int self)
+    {
+        for (int i = 0; i < nThreads; i++)
+        {
+            WorkRange& range = ranges[(self + i) % nThreads];
+            if (range.next.load(memory_order_relaxed) >= range.end)
+                continue;
+            int k = range.next.fetch_add(1, memory_order_relaxed);
+            if (k < range.end)
+                return k;
+        }
+        return -1;
+    }
+
+      // Spread nearby (seed, game) pairs over unrelated generator seeds
+    uint64_t gameSeed(uint64_t seed, int game)
+    {
+        return Rng(seed + game).next();
+    }
+}
+
+MonteCarloResult runMonteCarlo(const MonteCarloConfig& config)
+{
+    MonteCarloResult result(config.rows, config.cols);
+    int nThreads = config.nThreads < 1 ? 1 : config.nThreads;
+    auto start = chrono::steady_clock::now();
+
+      // Give each thread an equal share of the games up front
+    unique_ptr<WorkRange[]> ranges(new WorkRange[nThreads]);
+    for (int t = 0; t < nThreads; t++)
+    {
+        ranges[t].next = (long long) config.nGames * t / nThreads;
+        ranges[t].end = (long long) config.nGames * (t+1) / nThreads;
+    }
+
+    mutex resultLock;
+    auto worker = [&](int self) {
+        int wins = 0;
+        long turns = 0;
+        History heatmap(config.rows, config.cols);
+        for (int k = claimGame(ranges.get(), nThreads, self); k != -1;
+             k = claimGame(ranges.get(), nThreads, self))
+        {
+            Game g(config.rows, config.cols, config.nFlatulans,
+                   gameSeed(config.seed, k));
+            GameResult res = g.playHeadless(config.policy, config.maxTurns);
+            if (res.won)
+                wins++;
+            turns += res.turns;
+            heatmap.merge(g.city()->history());
+        }
+        lock_guard<mutex> guard(resultLock);
+        result.wins += wins;
+        result.totalTurns += turns;
+        result.heatmap.merge(heatmap);
+    };
+
+    vector<thread> threads;
+    for (int t = 1; t < nThreads; t++)
+        threads.emplace_back(worker, t);
+    worker(0);
+    for (thread& th : threads)
+        th.join();
+
+    result.games = config.nGames;
+    if (result.games > 0)
+    {
+        result.winRate = double(result.wins) / result.games;
+        result.meanTurns = double(result.totalTurns) / result.games;
+    }
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
\ No newline at end of file
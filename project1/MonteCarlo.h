@@ -0,0 +1,39 @@
+#ifndef MONTECARLO
+#define MONTECARLO
+
+#include "globals.h"
+#include "Game.h"
+#include "History.h"
+#include <cstdint>
+
+  // Describes a batch of independent headless games to run
+struct MonteCarloConfig
+{
+    int rows;
+    int cols;
+    int nFlatulans;
+    int nGames;
+    int nThreads;
+    int maxTurns;          // per game
+    std::uint64_t seed;    // game k is seeded from (seed, k) alone
+    PlayerPolicy policy;   // called concurrently; must not share mutable state
+};
+
+  // Results aggregated over every game in a batch.  Because each game is
+  // seeded from its own index, the results don't depend on nThreads.
+struct MonteCarloResult
+{
+    MonteCarloResult(int rows, int cols);
+
+    int     games;
+    int     wins;
+    long    totalTurns;
+    double  winRate;
+    double  meanTurns;
+    double  seconds;   // wall-clock time for the whole batch
+    History heatmap;   // every game's History merged together
+};
+
+MonteCarloResult runMonteCarlo(const MonteCarloConfig& config);
+
+#endif
\ No newline at end of file
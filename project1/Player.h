@@ -22,6 +22,8 @@ class Player
     void  getGassed();
 
   private:
+    friend class City;  // to copy and restore a player with its city
+
     City* m_city;
     int   m_row;
     int   m_col;
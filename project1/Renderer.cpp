@@ -0,0 +1,96 @@
+#include "Renderer.h"
+#include "globals.h"
+#include <cstdint>
+#include <cstring>
+#include <thread>
+using namespace std;
+
+Renderer::Renderer()
+ : m_rows(0), m_cols(0), m_valid(false), m_minInterval(0)
+{
+      // Cursor movement needs an ANSI terminal; anywhere else, fall back to
+      // clearScreen and a full redraw, exactly as before
+#ifdef _MSC_VER
+    m_ansi = false;
+#else
+    const char* term = getenv("TERM");
+    m_ansi = term != nullptr  &&  strcmp(term, "dumb") != 0;
+#endif
+}
+
+void Renderer::invalidate()
+{
+    m_valid = false;
+}
+
+void Renderer::setMaxFrameRate(double framesPerSecond)
+{
+    if (framesPerSecond <= 0)
+        m_minInterval = chrono::steady_clock::duration(0);
+    else
+        m_minInterval = chrono::duration_cast<chrono::steady_clock::duration>(
+                            chrono::duration<double>(1 / framesPerSecond));
+}
+
+void Renderer::waitForNextFrame()
+{
+    if (m_minInterval.count() > 0)
+    {
+        auto next = m_lastFrame + m_minInterval;
+        if (chrono::steady_clock::now() < next)
+            this_thread::sleep_until(next);
+    }
+    m_lastFrame = chrono::steady_clock::now();
+}
+
+void Renderer::draw(const vector<char>& grid, int rows, int cols,
+                    const string& status)
+{
+    waitForNextFrame();
+    string frame;
+    bool full = ! m_valid  ||  ! m_ansi  ||  rows != m_rows  ||  cols != m_cols;
+    if (full)
+    {
+        if (m_ansi)
+            frame += "\x1B[2J\x1B[H";  // clear the screen, cursor to top left
+        else
+            clearScreen();
+        frame.reserve(frame.size() + size_t(cols + 1) * rows + 1 + status.size());
+        for (int r = 0; r < rows; r++)
+        {
+            frame.append(&grid[size_t(r) * cols], cols);
+            frame += '\n';
+        }
+        frame += '\n';
+        frame += status;
+    }
+    else
+    {
+          // Rewrite only the changed cells; "ESC [ row ; col H" is 1-based.
+          // Writing a character leaves the cursor on the next cell of the
+          // row, so a run of changed cells needs only one cursor move.
+        size_t cursor = SIZE_MAX;
+        for (size_t k = 0; k < grid.size(); k++)
+        {
+            if (grid[k] == m_lastGrid[k])
+                continue;
+            if (k != cursor)
+                frame += "\x1B[" + to_string(k / cols + 1) + ";" + to_string(k % cols + 1) + "H";
+            frame += grid[k];
+            cursor = (k % cols == size_t(cols) - 1 ? SIZE_MAX : k + 1);
+        }
+          // The status lines can change length, and whatever was written
+          // after them last time (a prompt, say) must go, so always rewrite
+          // them and clear to the end of the screen
+        frame += "\x1B[" + to_string(rows + 2) + ";1H";
+        frame += status;
+        frame += "\x1B[J";
+    }
+    cout.write(frame.data(), frame.size());
+    cout.flush();
+
+    m_lastGrid = grid;
+    m_rows = rows;
+    m_cols = cols;
+    m_valid = true;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef RENDERER
+#define RENDERER
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+  // Draws successive frames of a character grid plus a few status lines.
+  // Each frame is built in one buffer and written with one call.  After the
+  // first frame, only the grid cells that changed are rewritten, using ANSI
+  // cursor movement, so a mostly-static board costs very little to redraw.
+class Renderer
+{
+  public:
+        // Constructor
+    Renderer();
+
+        // Mutators
+    void draw(const std::vector<char>& grid, int rows, int cols,
+              const std::string& status);
+    void invalidate();  // the screen was changed elsewhere; redraw it all
+    void setMaxFrameRate(double framesPerSecond);  // 0 means no limit
+
+  private:
+    std::vector<char> m_lastGrid;  // what's on the screen, if m_valid
+    int               m_rows;
+    int               m_cols;
+    bool              m_valid;
+    bool              m_ansi;      // false means redraw everything each frame
+    std::chrono::steady_clock::duration   m_minInterval;
+    std::chrono::steady_clock::time_point m_lastFrame;
+
+      // Helper functions
+    void waitForNextFrame();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "Rng.h"
+#include <random>
+using namespace std;
+
+namespace
+{
+    uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t splitmix64(uint64_t& x)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+}
+
+Rng::Rng(uint64_t seed)
+{
+    this->seed(seed);
+}
+
+void Rng::seed(uint64_t seed)
+{
+      // Expand the seed with splitmix64, as recommended for xoshiro, so that
+      // nearby seeds give unrelated sequences and the state is never all zero
+    for (int i = 0; i < 4; i++)
+        m_state[i] = splitmix64(seed);
+}
+
+uint64_t Rng::next()
+{
+    uint64_t* s = m_state;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+void Rng::getState(uint64_t state[4]) const
+{
+    for (int i = 0; i < 4; i++)
+        state[i] = m_state[i];
+}
+
+void Rng::setState(const uint64_t state[4])
+{
+    for (int i = 0; i < 4; i++)
+        m_state[i] = state[i];
+}
+
+  // Map 32 random bits onto [0, bound) by multiplication.  The bias is at
+  // most bound/2^32, far too small to matter for a game.
+uint32_t Rng::below(uint32_t bound, uint32_t bits) const
+{
+    return uint32_t((uint64_t(bits) * bound) >> 32);
+}
+
+int Rng::randInt(int min, int max)
+{
+    if (max < min)
+        std::swap(max, min);
+    uint32_t bound = uint32_t(max - min) + 1;
+    if (bound == 0)  // the full range of int
+        return int(uint32_t(next() >> 32));
+    return min + below(bound, uint32_t(next() >> 32));
+}
+
+void Rng::fill(vector<int>& out, int n, int min, int max)
+{
+    if (max < min)
+        std::swap(max, min);
+    out.resize(n);
+    uint32_t bound = uint32_t(max - min) + 1;
+    int k = 0;
+    if (bound == 0)  // the full range of int
+    {
+        for ( ; k < n; k++)
+            out[k] = int(uint32_t(next() >> 32));
+        return;
+    }
+    if ((bound & (bound - 1)) == 0)
+    {
+          // Power of 2: every draw supplies 64/log2(bound) results
+        int bitsPer = 0;
+        while ((1u << bitsPer) < bound)
+            bitsPer++;
+        if (bitsPer == 0)
+        {
+            for ( ; k < n; k++)
+                out[k] = min;
+            return;
+        }
+        int perDraw = 64 / bitsPer;
+        uint64_t mask = bound - 1;
+        while (k < n)
+        {
+            uint64_t bits = next();
+            for (int j = 0; j < perDraw  &&  k < n; j++, k++)
+            {
+                out[k] = min + int(bits & mask);
+                bits >>= bitsPer;
+            }
+        }
+        return;
+    }
+
+      // Otherwise each 64-bit draw supplies two 32-bit samples
+    while (k < n)
+    {
+        uint64_t bits = next();
+        out[k++] = min + below(bound, uint32_t(bits));
+        if (k < n)
+            out[k++] = min + below(bound, uint32_t(bits >> 32));
+    }
+}
+
+uint64_t randomSeed()
+{
+    random_device rd;
+    return (uint64_t(rd()) << 32) ^ rd();
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef RNG
+#define RNG
+
+#include <cstdint>
+#include <vector>
+
+  // A small, fast, explicitly seeded random number generator (xoshiro256**).
+  // Two Rngs constructed with the same seed produce the same sequence on
+  // every platform, so a game driven by one can be replayed exactly.
+class Rng
+{
+  public:
+        // Constructor
+    Rng(std::uint64_t seed);
+
+        // Mutators
+    void          seed(std::uint64_t seed);
+    std::uint64_t next();
+    int           randInt(int min, int max);
+    void          getState(std::uint64_t state[4]) const;
+    void          setState(const std::uint64_t state[4]);
+
+        // Replace the contents of out with n uniformly distributed ints from
+        // min to max, inclusive.  This is cheaper than n calls to randInt,
+        // especially when max-min+1 is a power of 2.
+    void          fill(std::vector<int>& out, int n, int min, int max);
+
+  private:
+    std::uint64_t m_state[4];
+
+      // Helper functions
+    std::uint32_t below(std::uint32_t bound, std::uint32_t bits) const;
+};
+
+  // Return a seed that is different on every run of the program
+std::uint64_t randomSeed();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "RolloutPlayer.h"
+#include "City.h"
+#include "Player.h"
+#include "Game.h"
+#include <chrono>
+#include <vector>
+using namespace std;
+
+namespace
+{
+    const char ACTIONS[] = { 'u', 'd', 'l', 'r', 'p' };
+    const int  NUMACTIONS = 5;
+
+      // Totals for the rollouts one worker has done from one move
+    struct Tally
+    {
+        double score[NUMACTIONS];
+        long   count[NUMACTIONS];
+    };
+}
+
+RolloutPlayer::RolloutPlayer(int nThreads, double msPerMove, int rolloutDepth,
+                             uint64_t seed)
+ : m_pool(nThreads), m_msPerMove(msPerMove), m_rolloutDepth(rolloutDepth),
+   m_seed(seed), m_nMoves(0), m_nRollouts(0), m_secondsSearching(0)
+{}
+
+long RolloutPlayer::rolloutCount() const
+{
+    return m_nRollouts;
+}
+
+double RolloutPlayer::rolloutsPerSecond() const
+{
+    return m_secondsSearching > 0 ? m_nRollouts / m_secondsSearching : 0;
+}
+
+void RolloutPlayer::setTimeBudget(double msPerMove)
+{
+    m_msPerMove = msPerMove;
+}
+
+char RolloutPlayer::chooseAction(const City& city)
+{
+    if (city.player() == nullptr)
+        return 'q';
+
+    auto start = chrono::steady_clock::now();
+    auto deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(
+                                chrono::duration<double, milli>(m_msPerMove));
+    vector<char> root;
+    city.saveSnapshot(root);
+
+      // Each worker restores the root state into its own scratch City and
+      // cycles through the actions until time runs out.  Every worker does
+      // at least one rollout per action, however small the budget.
+    int nWorkers = m_pool.size();
+    vector<Tally> tallies(nWorkers, Tally());
+    uint64_t moveSeed = Rng(m_seed + m_nMoves).next();
+    m_pool.run(nWorkers, [&](int task, int worker) {
+        uint64_t taskSeed = moveSeed ^ (uint64_t(task) << 48);
+        City scratch(1, 1, taskSeed);
+        Tally& tally = tallies[worker];
+        for (long k = 0; ; k++)
+        {
+            int a = k % NUMACTIONS;
+            if (a == 0  &&  k > 0  &&  chrono::steady_clock::now() >= deadline)
+                break;
+            scratch.restoreSnapshot(root);
+            tally.score[a] += rollout(scratch, ACTIONS[a], taskSeed ^ uint64_t(k));
+            tally.count[a]++;
+        }
+    });
+
+    double best = 0;
+    int bestAction = -1;
+    for (int a = 0; a < NUMACTIONS; a++)
+    {
+        double score = 0;
+        long count = 0;
+        for (const Tally& t : tallies)
+        {
+            score += t.score[a];
+            count += t.count[a];
+        }
+        m_nRollouts += count;
+        double mean = score / count;
+        if (bestAction == -1  ||  mean > best)
+        {
+            best = mean;
+            bestAction = a;
+        }
+    }
+    m_nMoves++;
+    m_secondsSearching += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return ACTIONS[bestAction];
+}
+
+  // Play firstAction and then up to m_rolloutDepth-1 random actions in city,
+  // and score the result: winning is best, and sooner is better; otherwise
+  // more health and fewer Flatulans left are better; passing out is worst.
+double RolloutPlayer::rollout(City& city, char firstAction, uint64_t seed) const
+{
+    city.rng().seed(seed);
+    Player* p = city.player();
+    playTurn(city, firstAction);
+    int turns = 1;
+    for ( ; turns < m_rolloutDepth; turns++)
+    {
+        if (p->isPassedOut()  ||  city.flatulanCount() == 0)
+            break;
+          // Random play, preaching three times out of four
+        int roll = city.rng().randInt(0, 4 * NUMDIRS - 1);
+        playTurn(city, roll >= NUMDIRS ? 'p' : ACTIONS[roll]);
+    }
+    if (p->isPassedOut())
+        return -1000 + turns;
+    if (city.flatulanCount() == 0)
+        return 1000 - turns;
+    return 10.0 * p->health() - city.flatulanCount();
+}
\ No newline at end of file
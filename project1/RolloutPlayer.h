@@ -0,0 +1,45 @@
+#ifndef ROLLOUTPLAYER
+#define ROLLOUTPLAYER
+
+#include "globals.h"
+#include "ThreadPool.h"
+#include <cstdint>
+
+  // An automated player that picks each action by Monte-Carlo search: for
+  // each of 'u', 'd', 'l', 'r', and 'p', it plays many short random games
+  // (rollouts) from a copy of the current city, starting with that action,
+  // and chooses the action whose rollouts scored best on average.  Rollouts
+  // run in parallel on a thread pool until the per-move time budget is used.
+  //
+  // To use one as a PlayerPolicy for Game::playHeadless:
+  //     RolloutPlayer ai(4, 5.0);
+  //     g.playHeadless([&ai](const City& c) { return ai.chooseAction(c); }, 1000);
+class RolloutPlayer
+{
+  public:
+        // Constructor
+    RolloutPlayer(int nThreads, double msPerMove, int rolloutDepth = 3,
+                  std::uint64_t seed = 1);
+
+        // Accessors
+    long   rolloutCount() const;       // over all moves so far
+    double rolloutsPerSecond() const;  // over all moves so far
+
+        // Mutators
+    char chooseAction(const City& city);
+    void setTimeBudget(double msPerMove);
+
+  private:
+    ThreadPool    m_pool;
+    double        m_msPerMove;
+    int           m_rolloutDepth;
+    std::uint64_t m_seed;
+    long          m_nMoves;
+    long          m_nRollouts;
+    double        m_secondsSearching;
+
+      // Helper functions
+    double rollout(City& city, char firstAction, std::uint64_t seed) const;
+};
+
+#endif
\ No newline at end of file
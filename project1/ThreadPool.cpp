@@ -0,0 +1,76 @@
+#include "ThreadPool.h"
+using namespace std;
+
+ThreadPool::ThreadPool(int nThreads)
+ : m_task(nullptr), m_nTasks(0), m_nextTask(0), m_busy(0), m_generation(0),
+   m_stopping(false)
+{
+    for (int w = 1; w < nThreads; w++)
+        m_threads.emplace_back(&ThreadPool::workerLoop, this, w);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> guard(m_lock);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (thread& t : m_threads)
+        t.join();
+}
+
+int ThreadPool::size() const
+{
+    return m_threads.size() + 1;
+}
+
+void ThreadPool::run(int nTasks, const function<void(int, int)>& task)
+{
+    {
+        lock_guard<mutex> guard(m_lock);
+        m_task = &task;
+        m_nTasks = nTasks;
+        m_nextTask = 0;
+        m_busy = m_threads.size();
+        m_generation++;
+    }
+    m_wake.notify_all();
+    work(0);
+
+      // Every helper takes part in every batch, even if there was nothing
+      // left for it to do, so the next batch can't start until they're done
+    unique_lock<mutex> guard(m_lock);
+    m_done.wait(guard, [this] { return m_busy == 0; });
+    m_task = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker)
+{
+    unsigned seen = 0;
+    for (;;)
+    {
+        {
+            unique_lock<mutex> guard(m_lock);
+            m_wake.wait(guard, [this, seen] {
+                return m_stopping  ||  m_generation != seen;
+            });
+            if (m_stopping)
+                return;
+            seen = m_generation;
+        }
+        work(worker);
+        {
+            lock_guard<mutex> guard(m_lock);
+            m_busy--;
+            if (m_busy == 0)
+                m_done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::work(int worker)
+{
+    for (int k = m_nextTask++; k < m_nTasks; k = m_nextTask++)
+        (*m_task)(k, worker);
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+// Measures the City operations that make up a turn, sweeping the city size
+// and the number of Flatulans.  Prints one record per (size, population,
+// operation) as CSV, or as a JSON array with --json, so results from
+// different versions can be compared.
+// Usage: benchCity [--json] [maxFlatulans]
+#include "City.h"
+#include "Player.h"
+#include "Rng.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+using namespace std;
+
+namespace
+{
+      // Swallows everything display() writes, so rendering can be timed
+      // without a terminal
+    class NullBuffer : public streambuf
+    {
+      protected:
+        int overflow(int c) { return c; }
+        streamsize xsputn(const char*, streamsize n) { return n; }
+    };
+
+    struct Record
+    {
+        int    rows;
+        int    cols;
+        int    flatulans;
+        string op;
+        long   iterations;
+        double nsPerOp;
+        double nsPerAgent;
+    };
+
+      // Keeps the compiler from discarding the lookups being timed
+    volatile long lookupSink;
+
+    double secondsSince(chrono::steady_clock::time_point start)
+    {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    void populate(City& city, int n, Rng& rng)
+    {
+        city.addPlayer((city.rows() + 1) / 2, (city.cols() + 1) / 2);
+        city.reserveFlatulans(n);
+        while (city.flatulanCount() < n)
+            city.addFlatulan(rng.randInt(1, city.rows()), rng.randInt(1, city.cols()));
+    }
+
+      // Run op repeatedly on a fresh copy of base for about 0.2 seconds
+    template <typename Op>
+    Record measure(const City& base, const string& name, Op op)
+    {
+        City city(base);
+        long iterations = 0;
+        auto start = chrono::steady_clock::now();
+        double secs = 0;
+        do
+        {
+            for (int i = 0; i < 16; i++)
+                op(city);
+            iterations += 16;
+            secs = secondsSince(start);
+        } while (secs < 0.2);
+        Record rec;
+        rec.rows = base.rows();
+        rec.cols = base.cols();
+        rec.flatulans = base.flatulanCount();
+        rec.op = name;
+        rec.iterations = iterations;
+        rec.nsPerOp = secs * 1e9 / iterations;
+        rec.nsPerAgent = rec.flatulans > 0 ? rec.nsPerOp / rec.flatulans : 0;
+        return rec;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bool json = false;
+    int maxFlatulans = 1000000;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0)
+            json = true;
+        else
+            maxFlatulans = atoi(argv[i]);
+    }
+
+    NullBuffer nullBuffer;
+    vector<Record> records;
+    Rng rng(2021);
+    const int sides[] = { 10, 100, 1000 };
+    for (int side : sides)
+    {
+        for (int n = 10; n <= maxFlatulans  &&  n < side * side; n *= 10)
+        {
+            City base(side, side, 42);
+            populate(base, n, rng);
+
+            records.push_back(measure(base, "moveFlatulans", [](City& c) {
+                c.moveFlatulans();
+            }));
+              // The player never passes out here, so every call preaches,
+              // but the population shrinks as Flatulans get converted;
+              // restoring them each time would swamp what's being measured
+            records.push_back(measure(base, "preachToFlatulansAroundPlayer", [](City& c) {
+                c.preachToFlatulansAroundPlayer();
+            }));
+            records.push_back(measure(base, "nFlatulansAt", [&rng, side](City& c) {
+                lookupSink += c.nFlatulansAt(rng.randInt(1, side), rng.randInt(1, side));
+            }));
+
+              // A full turn, without and then with rendering
+            auto turn = [](City& c) {
+                c.player()->move(c.rng().randInt(0, NUMDIRS-1));
+                c.moveFlatulans();
+            };
+            records.push_back(measure(base, "turn_render_off", turn));
+            streambuf* saved = cout.rdbuf(&nullBuffer);
+            Record rendered = measure(base, "turn_render_on", [&turn](City& c) {
+                turn(c);
+                c.display();
+            });
+            cout.rdbuf(saved);
+            records.push_back(rendered);
+        }
+    }
+
+    if (json)
+    {
+        cout << "[" << endl;
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            const Record& r = records[i];
+            cout << "  {\"rows\": " << r.rows << ", \"cols\": " << r.cols
+                 << ", \"flatulans\": " << r.flatulans << ", \"op\": \"" << r.op
+                 << "\", \"iterations\": " << r.iterations << ", \"ns_per_op\": "
+                 << r.nsPerOp << ", \"ns_per_agent\": " << r.nsPerAgent << "}"
+                 << (i + 1 < records.size() ? "," : "") << endl;
+        }
+        cout << "]" << endl;
+    }
+    else
+    {
+        cout << "rows,cols,flatulans,op,iterations,ns_per_op,ns_per_agent" << endl;
+        for (const Record& r : records)
+            cout << r.rows << "," << r.cols << "," << r.flatulans << "," << r.op
+                 << "," << r.iterations << "," << r.nsPerOp << "," << r.nsPerAgent << endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+// Measures how runMonteCarlo scales with the number of threads.
+// Usage: benchMonteCarlo [nGames] [maxThreads]
+#include "MonteCarlo.h"
+#include "City.h"
+#include "Player.h"
+#include <iostream>
+#include <cstdlib>
+#include <thread>
+using namespace std;
+
+  // Move toward the nearest corner of the city, preaching every other turn
+char cornerPolicy(const City& city)
+{
+    const Player* p = city.player();
+    if (p->age() % 2 == 0)
+        return 'p';
+    return p->row() > 1 ? 'u' : (p->col() > 1 ? 'l' : 'p');
+}
+
+int main(int argc, char* argv[])
+{
+    int nGames = argc > 1 ? atoi(argv[1]) : 20000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : 64;
+
+    MonteCarloConfig config;
+    config.rows = 7;
+    config.cols = 8;
+    config.nFlatulans = 25;
+    config.nGames = nGames;
+    config.maxTurns = 1000;
+    config.seed = 2021;
+    config.policy = cornerPolicy;
+
+    cout << "hardware threads: " << thread::hardware_concurrency() << endl;
+    cout << "threads,games,seconds,games_per_sec,speedup,win_rate,mean_turns" << endl;
+    double baseline = 0;
+    int baselineWins = -1;
+    for (int t = 1; t <= maxThreads; t *= 2)
+    {
+        config.nThreads = t;
+        MonteCarloResult res = runMonteCarlo(config);
+        double rate = res.games / res.seconds;
+        if (t == 1)
+        {
+            baseline = rate;
+            baselineWins = res.wins;
+        }
+        else if (res.wins != baselineWins)
+        {
+            cout << "***** results differ with " << t << " threads!" << endl;
+            return 1;
+        }
+        cout << t << "," << res.games << "," << res.seconds << "," << rate << ","
+             << rate / baseline << "," << res.winRate << "," << res.meanTurns << endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+// Compares the simple per-Flatulan loop in City::moveFlatulans with the
+// batch kernel, for 10^3 to 10^7 Flatulans.  Build with -O3 so the batch
+// kernel's first loop is vectorized.
+// Usage: benchMoveKernel [maxFlatulans]
+#include "City.h"
+#include "Rng.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <cstdlib>
+using namespace std;
+
+  // Average nanoseconds per Flatulan per turn of moveFlatulans
+double timeMoves(int nFlatulans, bool batch)
+{
+      // About four cells per Flatulan, in a square city
+    int side = int(sqrt(4.0 * nFlatulans)) + 1;
+    City city(side, side, 12345);
+    city.setBatchThreshold(batch ? 0 : nFlatulans + 1);
+    Rng rng(678);
+    city.reserveFlatulans(nFlatulans);
+    for (int k = 0; k < nFlatulans; k++)
+        city.addFlatulan(rng.randInt(1, side), rng.randInt(1, side));
+
+    int turns = 10000000 / nFlatulans + 3;
+    city.moveFlatulans();  // warm up
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < turns; t++)
+        city.moveFlatulans();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return secs * 1e9 / (double(turns) * nFlatulans);
+}
+
+int main(int argc, char* argv[])
+{
+    int maxFlatulans = argc > 1 ? atoi(argv[1]) : 10000000;
+    cout << "flatulans,scalar_ns_per_agent,batch_ns_per_agent,speedup" << endl;
+    for (int n = 1000; n <= maxFlatulans; n *= 10)
+    {
+        double scalar = timeMoves(n, false);
+        double batch = timeMoves(n, true);
+        cout << n << "," << scalar << "," << batch << "," << scalar / batch << endl;
+    }
+}
\ No newline at end of file
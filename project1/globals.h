@@ -13,9 +13,6 @@ class Game;
 class Player;
 class History;
 
-const int MAXROWS = 20;               // max number of rows in a city
-const int MAXCOLS = 30;               // max number of columns in a city
-const int MAXFLATULANS = 120;         // max number of Flatulans allowed
 const int INITIAL_PLAYER_HEALTH = 12;
 
 const int UP      = 0;
@@ -25,6 +22,7 @@ const int RIGHT   = 3;
 const int NUMDIRS = 4;
 
 int decodeDirection(char dir);
+std::size_t cellCount(int nRows, int nCols);  // 0 if the size is invalid
 int randInt(int min, int max);
 void clearScreen();
 
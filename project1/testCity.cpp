@@ -0,0 +1,229 @@
+#include "City.h"
+#include "Player.h"
+#include "Flatulan.h"
+#include <vector>
+#include <iostream>
+#include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+using namespace std;
+
+// Check the occupancy counts against a scan of every Flatulan
+void checkCounts(City& city)
+{
+    vector<int> scan(city.rows() * city.cols(), 0);
+    for (int k = 0; k < city.flatulanCount(); k++)
+    {
+        Flatulan f = city.flatulan(k);
+        scan[(f.row()-1) * city.cols() + f.col()-1]++;
+    }
+    for (int r = 1; r <= city.rows(); r++)
+        for (int c = 1; c <= city.cols(); c++)
+            assert(city.nFlatulansAt(r, c) == scan[(r-1) * city.cols() + c-1]);
+    Player* p = city.player();
+    if (p != nullptr)
+        assert(city.nFlatulansAt(p->row(), p->col()) == 0);
+}
+
+void test()
+{
+    for (int game = 0; game < 50; game++)
+    {
+        int rows = randInt(1, 20);
+        int cols = randInt(2, 30);
+        City city(rows, cols);
+        city.addPlayer(randInt(1, rows), randInt(1, cols));
+        Player* p = city.player();
+
+        int n = randInt(0, 120);
+        for (int k = 0; k < n; k++)
+        {
+            int r = randInt(1, rows);
+            int c = randInt(1, cols);
+            int before = city.nFlatulansAt(r, c);
+            if (city.addFlatulan(r, c))
+                assert(city.nFlatulansAt(r, c) == before + 1);
+            else
+                assert(city.isPlayerAt(r, c));
+        }
+        checkCounts(city);
+
+        assert(city.nFlatulansAt(0, 1) == 0);
+        assert(city.nFlatulansAt(rows + 1, cols) == 0);
+
+        for (int turn = 0; turn < 200  &&  ! p->isPassedOut(); turn++)
+        {
+            if (randInt(0, 4) == 0)
+            {
+                  // Preaching only affects the cells around the player
+                vector<int> before(rows * cols);
+                for (int r = 1; r <= rows; r++)
+                    for (int c = 1; c <= cols; c++)
+                        before[(r-1) * cols + c-1] = city.nFlatulansAt(r, c);
+                p->preach();
+                for (int r = 1; r <= rows; r++)
+                    for (int c = 1; c <= cols; c++)
+                    {
+                        int n = city.nFlatulansAt(r, c);
+                        if (abs(r - p->row()) <= 1  &&  abs(c - p->col()) <= 1)
+                            assert(n <= before[(r-1) * cols + c-1]);
+                        else
+                            assert(n == before[(r-1) * cols + c-1]);
+                    }
+            }
+            else
+                p->move(randInt(0, NUMDIRS-1));
+            checkCounts(city);
+            city.moveFlatulans();
+            checkCounts(city);
+        }
+    }
+
+    // The batch movement kernel gives the same result as the simple loop,
+    // down to the order of each cell's list, which decides who a seeded
+    // preach converts.  Half the games crowd the player and the Flatulans
+    // into a corner, so that many moves are blocked by the edge.
+    for (int game = 0; game < 40; game++)
+    {
+        bool corner = game % 2 == 1;
+        City scalar(15, 25, game);
+        City batch(15, 25, game);
+        scalar.setBatchThreshold(1000000);
+        batch.setBatchThreshold(0);
+        int pr = corner ? 1 : 8;
+        int pc = corner ? 1 : 12;
+        scalar.addPlayer(pr, pc);
+        batch.addPlayer(pr, pc);
+        for (int k = 0; k < 300; k++)
+        {
+            int r = corner ? randInt(1, 3) : randInt(1, 15);
+            int c = corner ? randInt(1, 4) : randInt(1, 25);
+            scalar.addFlatulan(r, c);
+            batch.addFlatulan(r, c);
+        }
+        for (int turn = 0; turn < 50; turn++)
+        {
+            int dir = randInt(0, NUMDIRS);
+            if (dir == NUMDIRS)
+            {
+                scalar.player()->preach();
+                batch.player()->preach();
+            }
+            else
+            {
+                scalar.player()->move(dir);
+                batch.player()->move(dir);
+            }
+            scalar.moveFlatulans();
+            batch.moveFlatulans();
+            assert(scalar.player()->health() == batch.player()->health());
+            assert(scalar.player()->row() == batch.player()->row());
+            assert(scalar.player()->col() == batch.player()->col());
+            assert(scalar.flatulanCount() == batch.flatulanCount());
+            for (int k = 0; k < scalar.flatulanCount(); k++)
+            {
+                assert(scalar.flatulan(k).row() == batch.flatulan(k).row());
+                assert(scalar.flatulan(k).col() == batch.flatulan(k).col());
+            }
+              // A snapshot includes the per-cell lists and the generator
+            vector<char> scalarState, batchState;
+            scalar.saveSnapshot(scalarState);
+            batch.saveSnapshot(batchState);
+            assert(scalarState == batchState);
+            checkCounts(batch);
+        }
+    }
+
+    // Snapshots and copies carry on exactly like the original
+    {
+        City orig(10, 12, 99);
+        orig.addPlayer(5, 6);
+        for (int k = 0; k < 80; k++)
+            orig.addFlatulan(randInt(1, 10), randInt(1, 12));
+        orig.player()->preach();
+        orig.moveFlatulans();
+
+        vector<char> snap;
+        orig.saveSnapshot(snap);
+        City restored(3, 3);
+        assert(restored.restoreSnapshot(snap));
+        assert(restored.rows() == 10  &&  restored.cols() == 12);
+        City copy(orig);
+        City assigned(4, 4);
+        assigned = orig;
+
+        vector<City*> cities = { &orig, &restored, &copy, &assigned };
+        for (int turn = 0; turn < 40; turn++)
+        {
+            int dir = turn % 5;
+            for (City* cp : cities)
+            {
+                if (dir == NUMDIRS)
+                    cp->player()->preach();
+                else
+                    cp->player()->move(dir);
+                cp->moveFlatulans();
+            }
+        }
+        vector<char> expected;
+        orig.saveSnapshot(expected);
+        for (City* cp : cities)
+        {
+            vector<char> got;
+            cp->saveSnapshot(got);
+            assert(got == expected);
+            assert(cp->player()->age() == orig.player()->age());
+            checkCounts(*cp);
+        }
+
+          // Damaged snapshots are rejected and leave the city alone
+        vector<char> bad(snap.begin(), snap.end() - 1);
+        assert( ! restored.restoreSnapshot(bad));
+        bad = snap;
+        bad[0] = 'X';
+        assert( ! restored.restoreSnapshot(bad));
+        int n;
+        memcpy(&n, snap.data() + 4 + 2 * sizeof(int), sizeof(int));
+        const size_t arrays = 4 + 8 * sizeof(int) + 4 * sizeof(uint64_t);
+        const size_t nexts = arrays + 2 * n * sizeof(int);
+        const size_t heads = arrays + 4 * n * sizeof(int) + 120 * sizeof(int);
+        struct { size_t offset; int value; } damage[] = {
+            { 4 + 4 * sizeof(int), 0 },  // player row
+            { 4 + 5 * sizeof(int), 13 },  // player column
+            { 4 + 6 * sizeof(int), INITIAL_PLAYER_HEALTH + 1 },  // player health
+            { 4 + 7 * sizeof(int), -1 },  // player age
+            { arrays, 11 },  // a Flatulan's row
+            { nexts, n },  // a next link
+            { nexts + n * sizeof(int), -2 },  // a prev link
+            { heads, 1000000 },  // a list head
+            { nexts, 0 },  // a next link looping back on itself
+            { 4, INT_MAX },  // rows, with a cell count that overflows
+            { 4 + sizeof(int), INT_MAX },  // columns, likewise
+        };
+        for (const auto& d : damage)
+        {
+            bad = snap;
+            memcpy(bad.data() + d.offset, &d.value, sizeof(int));
+            assert( ! restored.restoreSnapshot(bad));
+        }
+        vector<char> after;
+        restored.saveSnapshot(after);
+        assert(after == expected);
+    }
+
+    // A city much larger than the old fixed-size limits
+    City big(1000, 2000);
+    big.addPlayer(500, 1000);
+    for (int k = 0; k < 100000; k++)
+        big.addFlatulan(randInt(1, 1000), randInt(1, 999));
+    assert(big.flatulanCount() == 100000);
+    big.moveFlatulans();
+    checkCounts(big);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
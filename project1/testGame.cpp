@@ -0,0 +1,153 @@
+#include "Game.h"
+#include "City.h"
+#include "Player.h"
+#include "Flatulan.h"
+#include "MonteCarlo.h"
+#include "RolloutPlayer.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <cstdio>
+using namespace std;
+
+void test()
+{
+    // Scripted game: bad actions don't count as turns
+    Game g(5, 5, 3);
+    GameResult res = g.playHeadless("pxuu?dlr");
+    assert(res.turns <= 6);
+    assert(res.healthByTurn.size() == (size_t) res.turns);
+    for (int k = 1; k < res.turns; k++)
+        assert(res.healthByTurn[k] <= res.healthByTurn[k-1]);
+    assert( ! (res.won  &&  res.passedOut));
+
+    // A game with no Flatulans is won before any turn is taken
+    Game empty(3, 3, 0);
+    res = empty.playHeadless("uuu");
+    assert(res.won  &&  res.turns == 0);
+
+    // Policy that only preaches: every game ends in a win or a loss
+    int wins = 0;
+    for (int k = 0; k < 200; k++)
+    {
+        Game h(7, 8, 25);
+        res = h.playHeadless([](const City&) { return 'p'; }, 100000);
+        assert(res.won != res.passedOut);
+        assert(res.won == (h.city()->flatulanCount() == 0));
+        if (res.won)
+            wins++;
+    }
+    cout << "Preach-only policy won " << wins << " of 200 games" << endl;
+
+    // Quitting stops the game
+    Game q(7, 8, 25);
+    res = q.playHeadless([](const City&) { return 'q'; }, 100);
+    assert(res.turns == 0  &&  ! res.won  &&  ! res.passedOut);
+
+    // The same seed replays the same game
+    Game a(7, 8, 25, 32);
+    GameResult ra = a.playHeadless("ulpdrrpluupppp");
+    Game b(7, 8, 25, 32);
+    GameResult rb = b.playHeadless("ulpdrrpluupppp");
+    assert(ra.healthByTurn == rb.healthByTurn);
+    assert(a.city()->flatulanCount() == b.city()->flatulanCount());
+    for (int k = 0; k < a.city()->flatulanCount(); k++)
+    {
+        assert(a.city()->flatulan(k).row() == b.city()->flatulan(k).row());
+        assert(a.city()->flatulan(k).col() == b.city()->flatulan(k).col());
+    }
+    assert(a.city()->player()->row() == b.city()->player()->row());
+    assert(a.city()->player()->col() == b.city()->player()->col());
+
+    // A saved move log replays to the same result
+    Game logged(7, 8, 25, 1234);
+    GameResult rl = logged.playHeadless("ppxuulrrdpppllpp");
+    assert(logged.moveLog().size() == (size_t) rl.turns);
+    const char* logName = "testGame.log";
+    assert(logged.saveMoveLog(logName));
+    GameResult rr;
+    assert(replayGame(logName, rr));
+    assert(rr.turns == rl.turns  &&  rr.healthByTurn == rl.healthByTurn);
+    assert(rr.won == rl.won  &&  rr.passedOut == rl.passedOut);
+    remove(logName);
+    assert( ! replayGame("noSuchFile.log", rr));
+
+    // playTurn on a copy of a game's city follows the game exactly
+    Game played(7, 8, 25, 55);
+    City sim(*played.city());
+    for (char action : string("uxplrdpp"))
+    {
+        vector<char> before, simulated, real;
+        sim.saveSnapshot(before);
+        bool took = playTurn(sim, action);
+        sim.saveSnapshot(simulated);
+        assert(took == (action != 'x'));
+        assert(took  ||  simulated == before);
+        played.playHeadless(string(1, action));
+        played.city()->saveSnapshot(real);
+        assert(simulated == real);
+    }
+
+    // The rollout player always chooses a legal action
+    RolloutPlayer ai(3, 2.0, 3, 77);
+    int aiWins = 0;
+    for (int k = 0; k < 10; k++)
+    {
+        Game h(7, 8, 25, 500 + k);
+        res = h.playHeadless([&ai](const City& c) {
+            char action = ai.chooseAction(c);
+            assert(action == 'u' || action == 'd' || action == 'l' ||
+                   action == 'r' || action == 'p');
+            return action;
+        }, 1000);
+        assert(res.won != res.passedOut);
+        if (res.won)
+            aiWins++;
+    }
+    assert(ai.rolloutCount() > 0  &&  ai.rolloutsPerSecond() > 0);
+    cout << "Rollout player won " << aiWins << " of 10 games at "
+         << ai.rolloutsPerSecond() << " rollouts/s" << endl;
+
+    // Bulk-filled rolls stay in range and cover it
+    Rng rng(5);
+    vector<int> rolls;
+    int seen[7] = { 0 };
+    for (int min = -2; min <= 0; min++)
+    {
+        rng.fill(rolls, 1001, min, min + 3);
+        for (int v : rolls)
+            assert(v >= min  &&  v <= min + 3);
+        rng.fill(rolls, 999, min, min + 4);
+        assert(rolls.size() == 999);
+        for (int v : rolls)
+        {
+            assert(v >= min  &&  v <= min + 4);
+            seen[v + 2]++;
+        }
+    }
+    for (int v = 0; v < 7; v++)
+        assert(seen[v] > 0);
+
+    // Monte-Carlo results don't depend on the number of threads
+    MonteCarloConfig config;
+    config.rows = 6;
+    config.cols = 6;
+    config.nFlatulans = 10;
+    config.nGames = 300;
+    config.maxTurns = 500;
+    config.seed = 7;
+    config.policy = [](const City& c) { return c.player()->age() % 3 ? 'p' : 'r'; };
+    config.nThreads = 1;
+    MonteCarloResult m1 = runMonteCarlo(config);
+    config.nThreads = 4;
+    MonteCarloResult m4 = runMonteCarlo(config);
+    assert(m1.games == 300  &&  m4.games == 300);
+    assert(m1.wins == m4.wins  &&  m1.totalTurns == m4.totalTurns);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
\ No newline at end of file
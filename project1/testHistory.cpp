@@ -0,0 +1,102 @@
+#include "History.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+using namespace std;
+
+void test()
+{
+    History h(3, 4);
+    assert(h.rows() == 3  &&  h.cols() == 4);
+    assert(!h.record(0, 1));
+    assert(!h.record(3, 5));
+    for (int i = 0; i < 100; i++)
+        assert(h.record(2, 3));
+    assert(h.record(1, 1));
+    assert(h.count(2, 3) == 100);  // no longer capped at 26
+    assert(h.count(1, 1) == 1);
+    assert(h.count(3, 4) == 0);
+    assert(h.count(4, 4) == 0);
+
+    // Merging adds counts; sizes must match
+    History g(3, 4);
+    g.record(2, 3);
+    g.record(3, 4);
+    assert(h.merge(g));
+    assert(h.count(2, 3) == 101);
+    assert(h.count(3, 4) == 1);
+    History wrong(4, 3);
+    assert(!h.merge(wrong));
+
+    // Position counts past INT_MAX are computed in size_t; a size with too
+    // many positions, or none, makes an empty history
+    assert(cellCount(46341, 46341) == size_t(46341) * 46341);
+    assert(cellCount(0, 5) == 0  &&  cellCount(5, -1) == 0);
+    if (sizeof(size_t) == 8)
+        assert(cellCount(INT_MAX, INT_MAX) == 0);
+    History none(INT_MAX, INT_MAX);
+    assert(none.rows() == 0  &&  none.cols() == 0);
+    assert(!none.record(1, 1)  &&  none.count(1, 1) == 0);
+
+    // CSV export
+    const char* csvName = "testHistory.csv";
+    assert(h.exportCsv(csvName));
+    {
+        ifstream in(csvName);
+        stringstream contents;
+        contents << in.rdbuf();
+        assert(contents.str() == "1,0,0,0\n0,0,101,0\n0,0,0,1\n");
+    }
+    remove(csvName);
+
+    // Binary export
+    const char* binName = "testHistory.bin";
+    assert(h.exportBinary(binName));
+    {
+        ifstream in(binName, ios::binary);
+        string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        assert(bytes.size() == 4 + 4 * (2 + 12));
+        assert(bytes.substr(0, 4) == "FHST");
+        assert(bytes[4] == 3  &&  bytes[8] == 4);
+        assert(bytes[12] == 1);                       // (1,1)
+        assert((unsigned char) bytes[12 + 4*6] == 101);  // (2,3)
+    }
+    remove(binName);
+
+    // Displaying again rewrites only the positions that changed
+    setenv("TERM", "xterm", 1);
+    History d(2, 3);
+    d.record(1, 2);
+    stringstream screen;
+    streambuf* saved = cout.rdbuf(screen.rdbuf());
+    d.display();
+    string first = screen.str();
+    screen.str("");
+    d.record(2, 3);
+    d.record(2, 3);
+    d.record(1, 2);
+    d.display();
+    string second = screen.str();
+    screen.str("");
+    d.display();
+    string unchanged = screen.str();
+    screen.str("");
+    d.invalidateDisplay();
+    d.display();
+    string redrawn = screen.str();
+    cout.rdbuf(saved);
+    assert(first == "\x1B[2J\x1B[H.A.\n...\n\n");
+    assert(second == "\x1B[1;2HB\x1B[2;3HB\x1B[4;1H\x1B[J");
+    assert(unchanged == "\x1B[4;1H\x1B[J");
+    assert(redrawn == "\x1B[2J\x1B[H.B.\n..B\n\n");
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "Renderer.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <cstdlib>
+using namespace std;
+
+// Draw one frame with r and return what it wrote to cout
+string frame(Renderer& r, const string& cells, int rows, int cols, const string& status)
+{
+    stringstream screen;
+    streambuf* saved = cout.rdbuf(screen.rdbuf());
+    r.draw(vector<char>(cells.begin(), cells.end()), rows, cols, status);
+    cout.rdbuf(saved);
+    return screen.str();
+}
+
+void test()
+{
+    // On a dumb terminal every frame is a full redraw after clearScreen,
+    // which there just writes a newline
+    setenv("TERM", "dumb", 1);
+    Renderer dumb;
+    assert(frame(dumb, "ab" "cd", 2, 2, "s\n") == "\n" "ab\ncd\n\n" "s\n");
+    assert(frame(dumb, "ab" "cx", 2, 2, "t\n") == "\n" "ab\ncx\n\n" "t\n");
+
+    setenv("TERM", "xterm", 1);
+    Renderer r;
+
+    // The first frame clears the screen and writes everything
+    assert(frame(r, "...." "...." "....", 3, 4, "status\n") ==
+           "\x1B[2J\x1B[H" "....\n....\n....\n\n" "status\n");
+
+    // After that only changed cells are written; a run of them needs one
+    // cursor move, but a run doesn't carry over to the next row.  The
+    // status is always rewritten, then the rest of the screen cleared.
+    assert(frame(r, ".xyz" "w..." ".v.u", 3, 4, "st\n") ==
+           "\x1B[1;2Hxyz" "\x1B[2;1Hw" "\x1B[3;2Hv" "\x1B[3;4Hu"
+           "\x1B[5;1H" "st\n" "\x1B[J");
+
+    // Nothing changed: just the status
+    assert(frame(r, ".xyz" "w..." ".v.u", 3, 4, "st\n") ==
+           "\x1B[5;1H" "st\n" "\x1B[J");
+
+    // invalidate() forces a full redraw
+    r.invalidate();
+    assert(frame(r, ".xyz" "w..." ".v.u", 3, 4, "") ==
+           "\x1B[2J\x1B[H" ".xyz\nw...\n.v.u\n\n");
+
+    // So does a change of size
+    assert(frame(r, "ab" "cd", 2, 2, "") == "\x1B[2J\x1B[H" "ab\ncd\n\n");
+    assert(frame(r, "ab" "ce", 2, 2, "") == "\x1B[2;2He" "\x1B[4;1H" "\x1B[J");
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
@@ -1,6 +1,18 @@
 #include "globals.h"
+#include <cstdint>
 using namespace std;
 
+  // Return the number of positions in an nRows by nCols grid, or 0 if either
+  // is not positive or there are too many positions: the byte size of a few
+  // arrays with an 8-byte element per position must still fit in a size_t
+size_t cellCount(int nRows, int nCols)
+{
+    const size_t MAX_CELLS = SIZE_MAX / 32;
+    if (nRows <= 0  ||  nCols <= 0  ||  size_t(nRows) > MAX_CELLS / size_t(nCols))
+        return 0;
+    return size_t(nRows) * size_t(nCols);
+}
+
 int decodeDirection(char dir)
 {
     switch (dir)
@@ -13,15 +25,22 @@ int decodeDirection(char dir)
     return -1;  // bad argument passed in!
 }
 
+  // Each thread draws from its own generator, so games running on different
+  // threads don't share (or race on) one engine
+static default_random_engine& generator()
+{
+    thread_local random_device rd;
+    thread_local default_random_engine engine(rd());
+    return engine;
+}
+
   // Return a uniformly distributed random int from min to max, inclusive
 int randInt(int min, int max)
 {
     if (max < min)
         swap(max, min);
-    static random_device rd;
-    static default_random_engine generator(rd());
     uniform_int_distribution<> distro(min, max);
-    return distro(generator);
+    return distro(generator());
 }
 
 
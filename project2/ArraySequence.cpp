@@ -0,0 +1,351 @@
+#include "ArraySequence.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// The parallel scans give each task at least this many items, so that
+// handing out a task costs little next to doing it
+static const int MIN_CHUNK_ITEMS = 16384;
+
+ArraySequence::ArraySequence()
+{
+    items = nullptr;
+    num_items = 0;
+    capacity = 0;
+}
+
+ArraySequence::ArraySequence(const ArraySequence& other)
+{
+    num_items = other.num_items;
+    capacity = other.num_items;
+    items = nullptr;
+    if(capacity > 0)
+    {
+        items = new ItemType[capacity];
+        for(int i = 0; i < num_items; i++)
+            items[i] = other.items[i];
+    }
+}
+
+ArraySequence::~ArraySequence()
+{
+    delete [] items;
+}
+
+ArraySequence& ArraySequence::operator=(const ArraySequence& other)
+{
+    if(this == &other)
+        return *this;
+    ArraySequence tmp(other);
+    this->swap(tmp);
+    return *this;
+}
+
+bool ArraySequence::empty() const
+{
+    return num_items == 0;
+}
+
+int ArraySequence::size() const
+{
+    return num_items;
+}
+
+void ArraySequence::grow(int min_capacity)
+{
+    // Double the capacity (at least), so n appends cost O(n) in total
+    int new_capacity = capacity > 0 ? capacity * 2 : 8;
+    if(new_capacity < min_capacity)
+        new_capacity = min_capacity;
+    ItemType* new_items = new ItemType[new_capacity];
+    for(int i = 0; i < num_items; i++)
+        new_items[i] = std::move(items[i]);
+    delete [] items;
+    items = new_items;
+    capacity = new_capacity;
+}
+
+void ArraySequence::reserve(int capacity)
+{
+    if(capacity > this->capacity)
+        this->grow(capacity);
+}
+
+int ArraySequence::insert(int pos, const ItemType& value)
+{
+    if(pos < 0 || pos > num_items)
+        return -1;
+    // Copy value first, in case it refers to an item that grow() moves
+    ItemType tmp = value;
+    if(num_items == capacity)
+        this->grow(num_items + 1);
+    // Shift the items from pos on up one spot
+    for(int i = num_items; i > pos; i--)
+        items[i] = std::move(items[i - 1]);
+    items[pos] = std::move(tmp);
+    num_items++;
+    return pos;
+}
+
+int ArraySequence::insert(const ItemType& value)
+{
+    // Binary search isn't possible: the items need not be in order, and the
+    // spec asks for the first item >= value
+    int p = 0;
+    for( ; p < num_items; p++)
+    {
+        if(value <= items[p])
+            break;
+    }
+    return this->insert(p, value);
+}
+
+bool ArraySequence::erase(int pos)
+{
+    if(pos < 0 || pos >= num_items)
+        return false;
+    for(int i = pos; i < num_items - 1; i++)
+        items[i] = std::move(items[i + 1]);
+    num_items--;
+    items[num_items] = ItemType();
+    return true;
+}
+
+int ArraySequence::remove(const ItemType& value)
+{
+    // Compact the survivors toward the front in one pass
+    int kept = 0;
+    for(int i = 0; i < num_items; i++)
+    {
+        if(items[i] == value)
+            continue;
+        if(kept != i)
+            items[kept] = std::move(items[i]);
+        kept++;
+    }
+    int ctr = num_items - kept;
+    for(int i = kept; i < num_items; i++)
+        items[i] = ItemType();
+    num_items = kept;
+    return ctr;
+}
+
+bool ArraySequence::get(int pos, ItemType& value) const
+{
+    if(pos < 0 || pos >= num_items)
+        return false;
+    value = items[pos];
+    return true;
+}
+
+bool ArraySequence::set(int pos, const ItemType& value)
+{
+    if(pos < 0 || pos >= num_items)
+        return false;
+    items[pos] = value;
+    return true;
+}
+
+int ArraySequence::find(const ItemType& value) const
+{
+    for(int i = 0; i < num_items; i++)
+    {
+        if(items[i] == value)
+            return i;
+    }
+    return -1;
+}
+
+void ArraySequence::swap(ArraySequence& other)
+{
+    std::swap(items, other.items);
+    std::swap(num_items, other.num_items);
+    std::swap(capacity, other.capacity);
+}
+
+int ArraySequence::chunk_count(const ThreadPool& pool) const
+{
+    // A few chunks per thread, so one slow chunk doesn't hold up the rest
+    if(pool.size() == 1)
+        return 1;
+    int n = num_items / MIN_CHUNK_ITEMS;
+    if(n > 4 * pool.size())
+        n = 4 * pool.size();
+    return n > 0 ? n : 1;
+}
+
+int ArraySequence::parallel_find(const ItemType& value, ThreadPool& pool) const
+{
+    int n_chunks = this->chunk_count(pool);
+    if(n_chunks == 1)
+        return this->find(value);
+    // best is the first match found so far; a chunk gives up as soon as
+    // it's past that, since it can't find an earlier one
+    std::atomic<int> best(num_items);
+    pool.run(n_chunks, [&](int k, int) {
+        int start = (long long) num_items * k / n_chunks;
+        int end = (long long) num_items * (k + 1) / n_chunks;
+        if(start >= best)
+            return;
+        for(int i = start; i < end; i++)
+        {
+            if((i & 255) == 0 && i >= best.load(std::memory_order_relaxed))
+                return;
+            if(items[i] == value)
+            {
+                int b = best.load();
+                while(i < b && !best.compare_exchange_weak(b, i))
+                    ;
+                return;
+            }
+        }
+    });
+    return best < num_items ? best.load() : -1;
+}
+
+int ArraySequence::parallel_count(const ItemType& value, ThreadPool& pool) const
+{
+    int n_chunks = this->chunk_count(pool);
+    std::vector<int> counts(n_chunks, 0);
+    pool.run(n_chunks, [&](int k, int) {
+        int start = (long long) num_items * k / n_chunks;
+        int end = (long long) num_items * (k + 1) / n_chunks;
+        int ctr = 0;
+        for(int i = start; i < end; i++)
+        {
+            if(items[i] == value)
+                ctr++;
+        }
+        counts[k] = ctr;
+    });
+    int total = 0;
+    for(int c : counts)
+        total += c;
+    return total;
+}
+
+// Erase the items of items[0..num_items) for which keep returns false, and
+// return the new number of items.  Each chunk first compacts its own
+// survivors toward its front, in parallel.  A prefix sum of the survivor
+// counts then gives each chunk's run its place in the result.  A run's
+// place can overlap where an earlier run still is, so the runs are moved
+// out into uninitialized scratch memory and then back into place, each
+// step in parallel; the first run is already in place.
+template <typename Keep>
+static int compact(ItemType* items, int num_items, int n_chunks, ThreadPool& pool, const Keep& keep)
+{
+    std::vector<int> kept(n_chunks, 0);
+    pool.run(n_chunks, [&](int k, int) {
+        int start = (long long) num_items * k / n_chunks;
+        int end = (long long) num_items * (k + 1) / n_chunks;
+        int to = start;
+        for(int i = start; i < end; i++)
+        {
+            if(!keep(items[i]))
+                continue;
+            if(to != i)
+                items[to] = std::move(items[i]);
+            to++;
+        }
+        kept[k] = to - start;
+    });
+    // offset[k] is where chunk k's run goes
+    std::vector<int> offset(n_chunks + 1, 0);
+    for(int k = 0; k < n_chunks; k++)
+        offset[k + 1] = offset[k] + kept[k];
+    int total = offset[n_chunks];
+    std::allocator<ItemType> alloc;
+    ItemType* scratch = total > kept[0] ? alloc.allocate(total) : nullptr;
+    pool.run(n_chunks, [&](int k, int) {
+        int start = (long long) num_items * k / n_chunks;
+        if(k > 0)
+        {
+            for(int i = 0; i < kept[k]; i++)
+                new (&scratch[offset[k] + i]) ItemType(std::move(items[start + i]));
+        }
+    });
+    pool.run(n_chunks, [&](int k, int) {
+        int start = (long long) num_items * k / n_chunks;
+        int end = (long long) num_items * (k + 1) / n_chunks;
+        if(k > 0)
+        {
+            for(int i = offset[k]; i < offset[k + 1]; i++)
+            {
+                items[i] = std::move(scratch[i]);
+                scratch[i].~ItemType();
+            }
+        }
+        // Free what's left of the erased items
+        for(int i = std::max(start, total); i < end; i++)
+            items[i] = ItemType();
+    });
+    if(scratch != nullptr)
+        alloc.deallocate(scratch, total);
+    return total;
+}
+
+int ArraySequence::parallel_remove(const ItemType& value, ThreadPool& pool)
+{
+    int n = compact(items, num_items, this->chunk_count(pool), pool,
+                    [&value](const ItemType& item) { return !(item == value); });
+    int ctr = num_items - n;
+    num_items = n;
+    return ctr;
+}
+
+int ArraySequence::parallel_filter(const std::function<bool(const ItemType&)>& keep, ThreadPool& pool)
+{
+    int n = compact(items, num_items, this->chunk_count(pool), pool, keep);
+    int ctr = num_items - n;
+    num_items = n;
+    return ctr;
+}
+
+void ArraySequence::dump(bool multidump)
+{
+    std::cerr << "DUMPING: \n";
+    for(int i = 0; i < num_items; i++)
+        std::cerr << items[i] << " ";
+    std::cerr << std::endl;
+    if(multidump)
+    {
+        for(int i = num_items - 1; i >= 0; i--)
+            std::cerr << items[i] << " ";
+        std::cerr << std::endl;
+    }
+}
+
+// Determine if seq2 is a subsequence of seq1, by the same search as
+// Sequence's, comparing the items where they lie in the arrays
+int subsequence(const ArraySequence& seq1, const ArraySequence& seq2)
+{
+    const int size1 = seq1.num_items, size2 = seq2.num_items;
+    if(size1 == 0 || size2 == 0 || size2 > size1)
+        return -1;
+    const ItemType* pattern = seq2.items;
+    std::vector<int> matches = find_runs(seq1.items, seq1.items + size1,
+        [pattern](int j) -> const ItemType& { return pattern[j]; }, size2, 1);
+    return matches.empty() ? -1 : matches[0];
+}
+
+void interleave(const ArraySequence& seq1, const ArraySequence& seq2, ArraySequence& result)
+{
+    // Build into tmp, since result may be seq1 or seq2
+    ArraySequence tmp;
+    const int size1 = seq1.size(), size2 = seq2.size();
+    tmp.reserve(size1 + size2);
+    ItemType val;
+    for(int i = 0; i < size1 || i < size2; i++)
+    {
+        if(seq1.get(i, val))
+            tmp.insert(tmp.size(), val);
+        if(seq2.get(i, val))
+            tmp.insert(tmp.size(), val);
+    }
+    result.swap(tmp);
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef ARRAYSEQUENCE
+#define ARRAYSEQUENCE
+
+#include "Sequence.h"
+#include <functional>
+
+class ThreadPool;
+
+// Same interface and behavior as Sequence, but the items are kept in one
+// contiguous, growable array instead of a linked list.  get and set take
+// constant time, appending takes amortized constant time, and inserting or
+// erasing at pos moves only the items after pos.
+class ArraySequence
+{
+    public:
+        ArraySequence();    // Create an empty sequence (i.e., one with no items)
+        ArraySequence(const ArraySequence& other);
+        ~ArraySequence();
+        ArraySequence& operator=(const ArraySequence& other);
+        bool empty() const;
+        int size() const;
+        int insert(int pos, const ItemType& value);
+        int insert(const ItemType& value);
+        bool erase(int pos);
+        int remove(const ItemType& value);
+        bool get(int pos, ItemType& value) const;
+        bool set(int pos, const ItemType& value);
+        int find(const ItemType& value) const;
+        void swap(ArraySequence& other);
+        void reserve(int capacity);
+        // Make room for at least capacity items without reallocating
+
+        // Parallel versions of find and remove, plus count and filter,
+        // which split the array into chunks for pool's threads.  They give
+        // exactly the results the one-thread scans would: the same first
+        // position, the same count, the same survivors in the same order.
+        // Short sequences are just scanned on the calling thread.
+        int parallel_find(const ItemType& value, ThreadPool& pool) const;
+        int parallel_count(const ItemType& value, ThreadPool& pool) const;
+        int parallel_remove(const ItemType& value, ThreadPool& pool);
+        int parallel_filter(const std::function<bool(const ItemType&)>& keep, ThreadPool& pool);
+        // Erase every item for which keep returns false, and return the
+        // number erased.  keep is called from several threads at once.
+        void dump(bool multidump = false);
+    private:
+        friend int subsequence(const ArraySequence& seq1, const ArraySequence& seq2);
+        void grow(int min_capacity);
+        int chunk_count(const ThreadPool& pool) const;
+        ItemType* items;
+        int num_items;
+        int capacity;
+};
+
+int subsequence(const ArraySequence& seq1, const ArraySequence& seq2);
+
+void interleave(const ArraySequence& seq1, const ArraySequence& seq2, ArraySequence& result);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,297 @@
+#ifndef CONCURRENTSEQUENCE
+#define CONCURRENTSEQUENCE
+
+#include "PersistentSequence.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A number for each ConcurrentSequence, of any item type, made
+inline std::uint64_t next_concurrent_sequence_id()
+{
+    static std::atomic<std::uint64_t> count(0);
+    return ++count;
+}
+
+// A sequence that any number of threads can use at once.  It holds the
+// current version of a PersistentSequence.  Reads take no lock and write
+// nothing shared: a reader claims a hazard slot (normally the one it used
+// last, which no other thread has touched since), stores in it the address
+// of the current version, checks that the version is still current, reads
+// it and clears the slot.  So reads of one ConcurrentSequence from many
+// threads don't take turns at anything; benchConcurrentSequence measures
+// how they scale.  Writers take turns: each copies the current version
+// (O(1)), changes the copy and publishes it as the new current version.
+// The old version is freed by a later write once no hazard slot holds it,
+// so a version stays alive as long as any reader is still reading it.
+// Every operation takes effect at one instant, when it checks or publishes
+// a version.  The operations otherwise behave, and cost, as for
+// PersistentSequence.  The ConcurrentSequence mustn't be destroyed while
+// any thread is still using it.
+template <typename T>
+class ConcurrentSequence
+{
+    public:
+        ConcurrentSequence();    // Create an empty sequence (i.e., one with no items)
+        ConcurrentSequence(const ConcurrentSequence&) = delete;
+        ConcurrentSequence& operator=(const ConcurrentSequence&) = delete;
+        ~ConcurrentSequence();
+
+        bool empty() const;
+        int size() const;
+        bool get(int pos, T& value) const;
+        int find(const T& value) const;
+        // As for Sequence, on the current version.
+
+        PersistentSequence<T> snapshot() const;
+        // Return the current version, which later changes won't affect.
+        // Iterate over this, or use it for several reads that must agree.
+
+        int insert(int pos, const T& value);
+        int insert(const T& value);
+        bool erase(int pos);
+        int remove(const T& value);
+        bool set(int pos, const T& value);
+        // As for Sequence.
+
+        template <typename Edit>
+        auto update(Edit edit) -> decltype(edit(std::declval<PersistentSequence<T>&>()));
+        // Call edit on a copy of the current version, publish the result
+        // and return what edit returned, all as one operation.  If edit
+        // throws, the sequence is left unchanged.  edit mustn't use this
+        // ConcurrentSequence.
+
+    private:
+        using Version = PersistentSequence<T>;
+        struct alignas(64) Hazard
+        {
+            std::atomic<const Version*> version{nullptr};  // being read, if not null
+            std::atomic<bool> taken{true};                 // by a reader
+            Hazard* next = nullptr;
+        };
+        // Each on its own cache line, so readers using different slots
+        // don't slow each other down
+
+        class Reader
+        {
+            public:
+                explicit Reader(const ConcurrentSequence& seq);
+                ~Reader();
+                const Version& operator*() const { return *current; }
+                const Version* operator->() const { return current; }
+            private:
+                Hazard* hazard;
+                const Version* current;
+        };
+        // Claims a hazard slot and protects the current version with it
+        // for as long as the Reader lives
+
+        Hazard* claim() const;
+        // Return a slot this thread now has to itself, adding one if all
+        // are taken
+        void publish(const Version* next);
+        void reclaim();
+        // Make next the current version, and free every replaced version
+        // no hazard slot holds; the caller holds write_mutex
+
+        std::atomic<const Version*> version;  // the current version
+        mutable std::atomic<Hazard*> hazards; // a list of every slot made, never shrinking
+        std::vector<const Version*> retired;  // replaced but maybe still being read
+        std::mutex write_mutex;               // held by the one writer allowed at a time
+        const std::uint64_t id;               // never reused, unlike the address
+};
+
+template <typename T>
+ConcurrentSequence<T>::ConcurrentSequence()
+ : version(new Version), hazards(nullptr), id(next_concurrent_sequence_id())
+{
+}
+
+template <typename T>
+ConcurrentSequence<T>::~ConcurrentSequence()
+{
+    delete version.load();
+    for(const Version* v : retired)
+        delete v;
+    for(Hazard* h = hazards.load(); h != nullptr; )
+    {
+        Hazard* next = h->next;
+        delete h;
+        h = next;
+    }
+}
+
+template <typename T>
+typename ConcurrentSequence<T>::Hazard* ConcurrentSequence<T>::claim() const
+{
+    // Try the slot this thread last used on this sequence first: unless
+    // another thread needed an extra slot since, it's free and its cache
+    // line is still here
+    thread_local std::uint64_t last_id = 0;
+    thread_local Hazard* last = nullptr;
+    bool free = false;
+    if(last_id == id && !last->taken.load(std::memory_order_relaxed)
+       && last->taken.compare_exchange_strong(free, true, std::memory_order_acquire))
+        return last;
+    Hazard* h = hazards.load(std::memory_order_acquire);
+    for(; h != nullptr; h = h->next)
+    {
+        free = false;
+        if(!h->taken.load(std::memory_order_relaxed)
+           && h->taken.compare_exchange_strong(free, true, std::memory_order_acquire))
+            break;
+    }
+    if(h == nullptr)
+    {
+        h = new Hazard;
+        h->next = hazards.load(std::memory_order_relaxed);
+        while(!hazards.compare_exchange_weak(h->next, h, std::memory_order_release,
+                                             std::memory_order_relaxed))
+        {
+        }
+    }
+    last_id = id;
+    last = h;
+    return h;
+}
+
+template <typename T>
+ConcurrentSequence<T>::Reader::Reader(const ConcurrentSequence& seq)
+ : hazard(seq.claim()), current(seq.version.load(std::memory_order_relaxed))
+{
+    // Once the slot holds the version and the version is still current, a
+    // writer that replaces it will see the slot and not free it
+    for(;;)
+    {
+        hazard->version.store(current, std::memory_order_seq_cst);
+        const Version* now = seq.version.load(std::memory_order_seq_cst);
+        if(now == current)
+            break;
+        current = now;
+    }
+}
+
+template <typename T>
+ConcurrentSequence<T>::Reader::~Reader()
+{
+    hazard->version.store(nullptr, std::memory_order_release);
+    hazard->taken.store(false, std::memory_order_release);
+}
+
+template <typename T>
+void ConcurrentSequence<T>::reclaim()
+{
+    std::vector<const Version*> held;
+    for(Hazard* h = hazards.load(std::memory_order_acquire); h != nullptr; h = h->next)
+    {
+        const Version* v = h->version.load(std::memory_order_seq_cst);
+        if(v != nullptr)
+            held.push_back(v);
+    }
+    std::sort(held.begin(), held.end());
+    std::size_t kept = 0;
+    for(const Version* v : retired)
+    {
+        if(std::binary_search(held.begin(), held.end(), v))
+            retired[kept++] = v;
+        else
+            delete v;
+    }
+    retired.resize(kept);
+}
+
+template <typename T>
+bool ConcurrentSequence<T>::empty() const
+{
+    return Reader(*this)->empty();
+}
+
+template <typename T>
+int ConcurrentSequence<T>::size() const
+{
+    return Reader(*this)->size();
+}
+
+template <typename T>
+bool ConcurrentSequence<T>::get(int pos, T& value) const
+{
+    return Reader(*this)->get(pos, value);
+}
+
+template <typename T>
+int ConcurrentSequence<T>::find(const T& value) const
+{
+    return Reader(*this)->find(value);
+}
+
+template <typename T>
+PersistentSequence<T> ConcurrentSequence<T>::snapshot() const
+{
+    return *Reader(*this);
+}
+
+template <typename T>
+template <typename Edit>
+auto ConcurrentSequence<T>::update(Edit edit) -> decltype(edit(std::declval<PersistentSequence<T>&>()))
+{
+    std::lock_guard<std::mutex> lock(write_mutex);
+    // Only writers change version, so no reader protection is needed here
+    std::unique_ptr<Version> next(new Version(*version.load(std::memory_order_relaxed)));
+    // If edit throws, nothing is published
+    if constexpr(std::is_void<decltype(edit(*next))>::value)
+    {
+        edit(*next);
+        publish(next.release());
+    }
+    else
+    {
+        auto result = edit(*next);
+        publish(next.release());
+        return result;
+    }
+}
+
+template <typename T>
+void ConcurrentSequence<T>::publish(const Version* next)
+{
+    retired.push_back(version.exchange(next, std::memory_order_seq_cst));
+    reclaim();
+}
+
+template <typename T>
+int ConcurrentSequence<T>::insert(int pos, const T& value)
+{
+    return update([&](PersistentSequence<T>& s) { return s.insert(pos, value); });
+}
+
+template <typename T>
+int ConcurrentSequence<T>::insert(const T& value)
+{
+    return update([&](PersistentSequence<T>& s) { return s.insert(value); });
+}
+
+template <typename T>
+bool ConcurrentSequence<T>::erase(int pos)
+{
+    return update([&](PersistentSequence<T>& s) { return s.erase(pos); });
+}
+
+template <typename T>
+int ConcurrentSequence<T>::remove(const T& value)
+{
+    return update([&](PersistentSequence<T>& s) { return s.remove(value); });
+}
+
+template <typename T>
+bool ConcurrentSequence<T>::set(int pos, const T& value)
+{
+    return update([&](PersistentSequence<T>& s) { return s.set(pos, value); });
+}
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef HASHEDSTRING
+#define HASHEDSTRING
+
+#include "Sequence.h"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// A string that carries a 64-bit hash of itself, computed once when it's
+// made.  Two HashedStrings with different hashes (or sizes) are unequal, so
+// == almost never has to read the characters of a string that doesn't
+// match, only the two hashes stored beside them; strings that do agree on
+// hash and size are then compared with memcmp.  That makes it a better item
+// type than std::string for searching sequences of long, mostly distinct
+// keys, at the cost of 8 bytes per item and hashing each value stored or
+// searched for.  The string can't be changed in place; assign a new one.
+class HashedString
+{
+    public:
+        HashedString() : hash_value(hash(nullptr, 0)) {}
+        HashedString(const std::string& s) : text(s), hash_value(hash(s.data(), s.size())) {}
+        HashedString(const char* s) : HashedString(std::string(s)) {}
+
+        const std::string& str() const { return text; }
+        std::uint64_t hash() const { return hash_value; }
+        std::size_t size() const { return text.size(); }
+
+        friend bool operator==(const HashedString& a, const HashedString& b)
+        {
+            return a.hash_value == b.hash_value && a.text.size() == b.text.size()
+                && std::memcmp(a.text.data(), b.text.data(), a.text.size()) == 0;
+        }
+        friend bool operator!=(const HashedString& a, const HashedString& b) { return !(a == b); }
+        friend bool operator<=(const HashedString& a, const HashedString& b) { return a.text <= b.text; }
+        // Ordered as the strings are, for insert(value)
+        friend std::ostream& operator<<(std::ostream& out, const HashedString& s) { return out << s.text; }
+
+    private:
+        static std::uint64_t hash(const char* data, std::size_t size);
+        std::string text;
+        std::uint64_t hash_value;
+};
+
+// A sequence of strings with the hashed comparison
+using HashedSequence = BasicSequence<HashedString>;
+
+// Mix 8 bytes at a time, then finish with the splitmix64 finalizer so that
+// every bit of the input affects every bit of the hash
+inline std::uint64_t HashedString::hash(const char* data, std::size_t size)
+{
+    const std::uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+    std::uint64_t h = size * MULTIPLIER;
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        h = (h ^ word) * MULTIPLIER;
+        h ^= h >> 32;
+    }
+    if(i < size)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + i, size - i);
+        h = (h ^ word) * MULTIPLIER;
+    }
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
+
+#endif
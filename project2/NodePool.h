@@ -0,0 +1,188 @@
+#ifndef NODEPOOL
+#define NODEPOOL
+
+#include <cstddef>
+#include <new>
+
+// Hands out uninitialized memory for one NodeType at a time, carved from
+// large slabs, and takes it back onto a free list for reuse.  Allocating or
+// freeing a node is a few pointer operations; only a new slab calls
+// operator new, and the slabs are freed all at once when the pool is
+// destroyed.  A pool may be shared by several sequences, but it isn't
+// thread-safe, so they must all be used from one thread.
+template <typename NodeType>
+class NodePool
+{
+    public:
+        NodePool(int first_slab_nodes = 16, int max_slab_nodes = 4096);
+        ~NodePool();
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+
+        void* allocate();
+        // Return memory for one NodeType.
+
+        void deallocate(void* p);
+        // Take back memory that allocate() returned, for reuse.
+
+        void clear();
+        // Make all the memory in the pool available again at once.  Every
+        // node handed out must already have been destroyed, or be abandoned.
+
+        void adopt(NodePool& other);
+        // Take over all of other's slabs, leaving other empty, so nodes
+        // that other handed out can be given back to this pool.  Memory
+        // other hadn't handed out isn't reused until clear().  Doesn't
+        // allocate.
+
+        long node_allocations() const;
+        // Number of times allocate() has been called.
+
+        long heap_allocations() const;
+        // Number of slabs obtained from operator new; without the pool,
+        // this would have been node_allocations().
+
+    private:
+        // Each slab starts with a header linking it to the next, and the
+        // nodes follow
+        struct Slab
+        {
+            Slab* next;
+            int nodes;  // capacity, in nodes
+        };
+        struct FreeNode
+        {
+            FreeNode* next;
+        };
+        static const size_t NODE_SIZE =
+            sizeof(NodeType) > sizeof(FreeNode) ? sizeof(NodeType) : sizeof(FreeNode);
+        static const size_t HEADER_SIZE =
+            (sizeof(Slab) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+        Slab* first_slab;     // slabs before current are used up
+        Slab* last_slab;
+        Slab* current_slab;   // slab that fresh nodes come from; null if none yet
+        int used_in_current;  // nodes handed out from it so far
+        FreeNode* free_list;
+        int first_slab_nodes;
+        int max_slab_nodes;
+        long num_allocations;
+        long num_slabs;
+};
+
+template <typename NodeType>
+NodePool<NodeType>::NodePool(int first_slab_nodes, int max_slab_nodes)
+{
+    first_slab = last_slab = current_slab = nullptr;
+    used_in_current = 0;
+    free_list = nullptr;
+    this->first_slab_nodes = first_slab_nodes > 0 ? first_slab_nodes : 1;
+    this->max_slab_nodes = max_slab_nodes > this->first_slab_nodes ?
+                           max_slab_nodes : this->first_slab_nodes;
+    num_allocations = 0;
+    num_slabs = 0;
+}
+
+template <typename NodeType>
+NodePool<NodeType>::~NodePool()
+{
+    Slab* slab = first_slab;
+    while(slab != nullptr)
+    {
+        Slab* tmp = slab->next;
+        ::operator delete(slab);
+        slab = tmp;
+    }
+}
+
+template <typename NodeType>
+void* NodePool<NodeType>::allocate()
+{
+    num_allocations++;
+    // Reuse a freed node if there is one
+    if(free_list != nullptr)
+    {
+        FreeNode* p = free_list;
+        free_list = p->next;
+        return p;
+    }
+    // Otherwise take the next fresh node, moving on to the next slab (or
+    // making one, each twice as big as the last, up to a limit) if needed
+    if(current_slab == nullptr || used_in_current == current_slab->nodes)
+    {
+        Slab* next = current_slab == nullptr ? first_slab : current_slab->next;
+        if(next == nullptr)
+        {
+            int n = first_slab_nodes;
+            if(last_slab != nullptr)
+                n = 2 * last_slab->nodes < max_slab_nodes ? 2 * last_slab->nodes : max_slab_nodes;
+            next = static_cast<Slab*>(::operator new(HEADER_SIZE + n * NODE_SIZE));
+            next->next = nullptr;
+            next->nodes = n;
+            if(last_slab == nullptr)
+                first_slab = next;
+            else
+                last_slab->next = next;
+            last_slab = next;
+            num_slabs++;
+        }
+        current_slab = next;
+        used_in_current = 0;
+    }
+    void* p = reinterpret_cast<char*>(current_slab) + HEADER_SIZE + used_in_current * NODE_SIZE;
+    used_in_current++;
+    return p;
+}
+
+template <typename NodeType>
+void NodePool<NodeType>::deallocate(void* p)
+{
+    FreeNode* node = static_cast<FreeNode*>(p);
+    node->next = free_list;
+    free_list = node;
+}
+
+template <typename NodeType>
+void NodePool<NodeType>::clear()
+{
+    current_slab = nullptr;
+    used_in_current = 0;
+    free_list = nullptr;
+}
+
+template <typename NodeType>
+void NodePool<NodeType>::adopt(NodePool& other)
+{
+    if(&other == this || other.first_slab == nullptr)
+        return;
+    // Other's slabs go in front, with the used-up ones
+    other.last_slab->next = first_slab;
+    if(last_slab == nullptr)
+        last_slab = other.last_slab;
+    first_slab = other.first_slab;
+    if(current_slab == nullptr)
+    {
+        current_slab = other.last_slab;
+        used_in_current = current_slab->nodes;
+    }
+    num_allocations += other.num_allocations;
+    num_slabs += other.num_slabs;
+    other.first_slab = other.last_slab = other.current_slab = nullptr;
+    other.used_in_current = 0;
+    other.free_list = nullptr;
+    other.num_allocations = 0;
+    other.num_slabs = 0;
+}
+
+template <typename NodeType>
+long NodePool<NodeType>::node_allocations() const
+{
+    return num_allocations;
+}
+
+template <typename NodeType>
+long NodePool<NodeType>::heap_allocations() const
+{
+    return num_slabs;
+}
+
+#endif
\ No newline at end of file
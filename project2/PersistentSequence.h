@@ -0,0 +1,363 @@
+#ifndef PERSISTENTSEQUENCE
+#define PERSISTENTSEQUENCE
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// A sequence for keeping many versions of: copying one is O(1), and
+// changing one leaves every copy as it was.  The items are kept in a
+// balanced tree (a treap, ordered by position) whose nodes are never
+// changed once made; an edit makes new copies of just the O(log n) nodes
+// on the path to the change, and shares everything else with the old
+// version.  So memory grows with the number of edits, not the size of each
+// version.  Positional operations take O(log n) expected time; ordered
+// insert, find and remove have to look at the items in order, so they take
+// O(n), as for Sequence.  Different versions can be used from different
+// threads at once, but one PersistentSequence object can't be.
+template <typename T>
+class PersistentSequence
+{
+    private:
+        struct Node;
+        using NodePtr = std::shared_ptr<const Node>;
+    public:
+        PersistentSequence();    // Create an empty sequence (i.e., one with no items)
+        // The copy constructor and assignment operator just share the tree.
+        bool empty() const;  // Return true if the sequence is empty, otherwise false.
+        int size() const;    // Return the number of items in the sequence.
+
+        int insert(int pos, const T& value);
+        // Insert value so that it becomes the item at position pos, and
+        // return pos, if 0 <= pos <= size().  Otherwise, leave the sequence
+        // unchanged and return -1.
+
+        int insert(const T& value);
+        // Let p be the smallest integer such that value <= the item at
+        // position p (or size() if there is none).  Insert value so that
+        // it becomes the item at position p, and return p.
+
+        bool erase(int pos);
+        // If 0 <= pos < size(), remove the item at position pos and return
+        // true.  Otherwise, leave the sequence unchanged and return false.
+
+        int remove(const T& value);
+        // Erase all items that == value.  Return the number removed.
+
+        bool get(int pos, T& value) const;
+        // If 0 <= pos < size(), copy into value the item at position pos
+        // and return true.  Otherwise, leave value unchanged and return false.
+
+        bool set(int pos, const T& value);
+        // If 0 <= pos < size(), replace the item at position pos with value
+        // and return true.  Otherwise, leave the sequence unchanged and
+        // return false.
+
+        int find(const T& value) const;
+        // Return the smallest p such that value == the item at position p,
+        // or -1 if there is none.
+
+        void swap(PersistentSequence& other);
+        // Exchange the contents of this sequence with the other one.
+
+        class const_iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+
+                const_iterator() {}
+                reference operator*() const { return path.back()->val; }
+                pointer operator->() const { return &path.back()->val; }
+                const_iterator& operator++()
+                {
+                    // The next node is the leftmost one in the right
+                    // subtree, or else the nearest ancestor we're left of
+                    const Node* node = path.back();
+                    if(node->right != nullptr)
+                        descend_left(node->right.get());
+                    else
+                    {
+                        path.pop_back();
+                        while(!path.empty() && path.back()->right.get() == node)
+                        {
+                            node = path.back();
+                            path.pop_back();
+                        }
+                    }
+                    return *this;
+                }
+                const_iterator operator++(int)
+                {
+                    const_iterator old = *this;
+                    ++*this;
+                    return old;
+                }
+                friend bool operator==(const const_iterator& a, const const_iterator& b)
+                {
+                    if(a.path.empty() || b.path.empty())
+                        return a.path.empty() && b.path.empty();
+                    return a.path.back() == b.path.back();
+                }
+                friend bool operator!=(const const_iterator& a, const const_iterator& b) { return !(a == b); }
+            private:
+                friend class PersistentSequence;
+                void descend_left(const Node* node)
+                {
+                    for( ; node != nullptr; node = node->left.get())
+                        path.push_back(node);
+                }
+                std::vector<const Node*> path;  // root down to the current node; empty at end()
+        };
+        const_iterator begin() const;
+        const_iterator end() const;
+        // Forward iterators over the items in order.  They stay valid as
+        // long as this version of the sequence (or a copy) exists.
+
+    private:
+        struct Node
+        {
+            Node(const T& val, uint32_t priority, NodePtr left, NodePtr right)
+                : val(val), priority(priority), size(1 + count(left) + count(right)),
+                  left(std::move(left)), right(std::move(right)) {}
+            T val;
+            uint32_t priority;  // higher than any in its subtrees
+            int size;           // number of items in this subtree
+            NodePtr left;
+            NodePtr right;
+        };
+        static int count(const NodePtr& node);
+        static uint32_t random_priority();
+        static NodePtr with_children(const Node& node, NodePtr left, NodePtr right);
+        static NodePtr join(const NodePtr& a, const NodePtr& b);
+        static void split(NodePtr node, int k, NodePtr& first, NodePtr& rest);
+        static NodePtr replace(const NodePtr& node, int pos, const T& value);
+        static NodePtr without(const NodePtr& node, const T& value, int& removed);
+        NodePtr root;
+};
+
+template <typename T>
+PersistentSequence<T>::PersistentSequence()
+{
+}
+
+template <typename T>
+bool PersistentSequence<T>::empty() const
+{
+    return root == nullptr;
+}
+
+template <typename T>
+int PersistentSequence<T>::size() const
+{
+    return count(root);
+}
+
+template <typename T>
+int PersistentSequence<T>::count(const NodePtr& node)
+{
+    return node == nullptr ? 0 : node->size;
+}
+
+template <typename T>
+uint32_t PersistentSequence<T>::random_priority()
+{
+    // splitmix64 of a per-thread counter
+    thread_local uint64_t state = 0x9E3779B97F4A7C15ULL ^ (uintptr_t) &state;
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (uint32_t) (z ^ (z >> 31));
+}
+
+template <typename T>
+typename PersistentSequence<T>::NodePtr PersistentSequence<T>::with_children(const Node& node, NodePtr left, NodePtr right)
+{
+    return std::make_shared<const Node>(node.val, node.priority, std::move(left), std::move(right));
+}
+
+template <typename T>
+typename PersistentSequence<T>::NodePtr PersistentSequence<T>::join(const NodePtr& a, const NodePtr& b)
+{
+    // All of a's items, then all of b's
+    if(a == nullptr)
+        return b;
+    if(b == nullptr)
+        return a;
+    if(a->priority > b->priority)
+        return with_children(*a, a->left, join(a->right, b));
+    else
+        return with_children(*b, join(a, b->left), b->right);
+}
+
+template <typename T>
+void PersistentSequence<T>::split(NodePtr node, int k, NodePtr& first, NodePtr& rest)
+{
+    // Set first to the first k items of node's subtree, rest to the others
+    if(node == nullptr)
+    {
+        first = rest = nullptr;
+        return;
+    }
+    int left_size = count(node->left);
+    if(k <= left_size)
+    {
+        NodePtr tmp;
+        split(node->left, k, first, tmp);
+        rest = with_children(*node, tmp, node->right);
+    }
+    else
+    {
+        NodePtr tmp;
+        split(node->right, k - left_size - 1, tmp, rest);
+        first = with_children(*node, node->left, tmp);
+    }
+}
+
+template <typename T>
+typename PersistentSequence<T>::NodePtr PersistentSequence<T>::replace(const NodePtr& node, int pos, const T& value)
+{
+    // Copy the path down to position pos, with value there instead
+    int left_size = count(node->left);
+    if(pos < left_size)
+        return with_children(*node, replace(node->left, pos, value), node->right);
+    if(pos > left_size)
+        return with_children(*node, node->left, replace(node->right, pos - left_size - 1, value));
+    return std::make_shared<const Node>(value, node->priority, node->left, node->right);
+}
+
+template <typename T>
+typename PersistentSequence<T>::NodePtr PersistentSequence<T>::without(const NodePtr& node, const T& value, int& removed)
+{
+    // Subtrees with nothing to remove are shared, not copied
+    if(node == nullptr)
+        return nullptr;
+    NodePtr left = without(node->left, value, removed);
+    NodePtr right = without(node->right, value, removed);
+    if(node->val == value)
+    {
+        removed++;
+        return join(left, right);
+    }
+    if(left == node->left && right == node->right)
+        return node;
+    return with_children(*node, std::move(left), std::move(right));
+}
+
+template <typename T>
+int PersistentSequence<T>::insert(int pos, const T& value)
+{
+    if(pos < 0 || pos > size())
+        return -1;
+    NodePtr first, rest;
+    split(root, pos, first, rest);
+    NodePtr node = std::make_shared<const Node>(value, random_priority(), nullptr, nullptr);
+    root = join(join(first, node), rest);
+    return pos;
+}
+
+template <typename T>
+int PersistentSequence<T>::insert(const T& value)
+{
+    // Determine where to insert
+    int p = 0;
+    for(const_iterator iter = begin(); iter != end(); ++iter, p++)
+    {
+        if(value <= *iter)
+            break;
+    }
+    return this->insert(p, value);
+}
+
+template <typename T>
+bool PersistentSequence<T>::erase(int pos)
+{
+    if(pos < 0 || pos >= size())
+        return false;
+    NodePtr first, middle, item, rest;
+    split(root, pos, first, middle);
+    split(middle, 1, item, rest);
+    root = join(first, rest);
+    return true;
+}
+
+template <typename T>
+int PersistentSequence<T>::remove(const T& value)
+{
+    int removed = 0;
+    root = without(root, value, removed);
+    return removed;
+}
+
+template <typename T>
+bool PersistentSequence<T>::get(int pos, T& value) const
+{
+    if(pos < 0 || pos >= size())
+        return false;
+    const Node* node = root.get();
+    for(;;)
+    {
+        int left_size = count(node->left);
+        if(pos < left_size)
+            node = node->left.get();
+        else if(pos > left_size)
+        {
+            pos -= left_size + 1;
+            node = node->right.get();
+        }
+        else
+            break;
+    }
+    value = node->val;
+    return true;
+}
+
+template <typename T>
+bool PersistentSequence<T>::set(int pos, const T& value)
+{
+    if(pos < 0 || pos >= size())
+        return false;
+    root = replace(root, pos, value);
+    return true;
+}
+
+template <typename T>
+int PersistentSequence<T>::find(const T& value) const
+{
+    int p = 0;
+    for(const T& item : *this)
+    {
+        if(item == value)
+            return p;
+        p++;
+    }
+    return -1;
+}
+
+template <typename T>
+void PersistentSequence<T>::swap(PersistentSequence& other)
+{
+    root.swap(other.root);
+}
+
+template <typename T>
+typename PersistentSequence<T>::const_iterator PersistentSequence<T>::begin() const
+{
+    const_iterator iter;
+    iter.descend_left(root.get());
+    return iter;
+}
+
+template <typename T>
+typename PersistentSequence<T>::const_iterator PersistentSequence<T>::end() const
+{
+    return const_iterator();
+}
+
+#endif
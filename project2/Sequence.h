@@ -1,19 +1,55 @@
 #ifndef SEQUENCE
 #define SEQUENCE
 
+#include "NodePool.h"
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 using ItemType = std::string;
 
-class Sequence
+// A doubly-linked list of items of type T.  Sequence is the sequence of
+// ItemType; other item types use BasicSequence<T> directly.  Nodes come from
+// a NodePool, which the sequence makes for itself unless it's given one to
+// share.  Positional operations walk from whichever is nearest of the head,
+// the tail and the node last changed by position (the finger), so working
+// through nearby positions in turn with insert, erase or set is O(1) per
+// call, as is inserting at size().  get() and the other const operations
+// don't move the finger, so any number of threads may read a sequence at
+// once while nobody changes it; to read through nearby positions in turn,
+// use a Cursor.
+template <typename T>
+class BasicSequence
 {
+    private:
+        class Node;
+        template <typename U> class Iterator;
     public:
-        Sequence();    // Create an empty sequence (i.e., one with no items)
-        Sequence(const Sequence& other);
-        ~Sequence();
-        Sequence& operator=(const Sequence& other);
+        class Cursor;
+        using Pool = NodePool<Node>;
+        using iterator = Iterator<T>;
+        using const_iterator = Iterator<const T>;
+        BasicSequence();    // Create an empty sequence (i.e., one with no items)
+        explicit BasicSequence(Pool& pool);
+        // Create an empty sequence whose nodes come from pool, which may be
+        // shared with other sequences used on the same thread.  The pool
+        // must outlive the sequence.
+        BasicSequence(const BasicSequence& other);
+        BasicSequence(BasicSequence&& other) noexcept;
+        // Take other's items (and their pool) without copying them,
+        // leaving other empty
+        ~BasicSequence();
+        BasicSequence& operator=(const BasicSequence& other);
+        BasicSequence& operator=(BasicSequence&& other) noexcept;
         bool empty() const;  // Return true if the sequence is empty, otherwise false.
         int size() const;    // Return the number of items in the sequence.
-        int insert(int pos, const ItemType& value);
+        int insert(int pos, const T& value);
+        int insert(int pos, T&& value);
         // Insert value into the sequence so that it becomes the item at
         // position pos.  The original item at position pos and those that
         // follow it end up at positions one higher than they were at before.
@@ -22,8 +58,15 @@ class Sequence
         // e.g., because it's implemented using a fixed-size array.)  Otherwise,
         // leave the sequence unchanged and return -1.  Notice that
         // if pos is equal to size(), the value is inserted at the end.
+        // The T&& version moves value into the sequence instead of copying.
+
+        template <typename... Args>
+        int emplace(int pos, Args&&... args);
+        // Like insert(pos, value), but the new item is constructed in place
+        // from args, so no temporary T is made.
 
-        int insert(const ItemType& value);
+        int insert(const T& value);
+        int insert(T&& value);
         // Let p be the smallest integer such that value <= the item at
         // position p in the sequence; if no such item exists (i.e.,
         // value > all items in the sequence), let p be size().  Insert
@@ -39,48 +82,955 @@ class Sequence
         // positions one lower than they were at before), and return true.
         // Otherwise, leave the sequence unchanged and return false.
         
-        int remove(const ItemType& value);
+        int remove(const T& value);
         // Erase all items from the sequence that == value.  Return the
         // number of items removed (which will be 0 if no item == value).
 
-        bool get(int pos, ItemType& value) const;
+        bool get(int pos, T& value) const;
         // If 0 <= pos < size(), copy into value the item at position pos
         // of the sequence and return true.  Otherwise, leave value unchanged
         // and return false.
 
-        bool set(int pos, const ItemType& value);
+        bool set(int pos, const T& value);
         // If 0 <= pos < size(), replace the item at position pos in the
         // sequence with value and return true.  Otherwise, leave the sequence
         // unchanged and return false.
 
-        int find(const ItemType& value) const;
+        int find(const T& value) const;
         // Let p be the smallest integer such that value == the item at
         // position p in the sequence; if no such item exists, let p be -1.
         // Return p.
 
-        void swap(Sequence& other);
+        void swap(BasicSequence& other);
         // Exchange the contents of this sequence with the other one.
 
-        void dump(bool multidump = false);
+        template <typename InputIt>
+        void append(InputIt first, InputIt last);
+        // Add copies of the items in [first, last) to the end of the
+        // sequence, in order.  The range must not be from this sequence.
+
+        int splice(int pos, BasicSequence& other);
+        // Move all of other's items into this sequence so that the first of
+        // them becomes the item at position pos, leaving other empty.  The
+        // nodes are relinked rather than copied, so this takes O(1) time at
+        // either end (otherwise, the time to walk to pos).  Return pos if
+        // 0 <= pos <= size() and other isn't this sequence; otherwise leave
+        // both unchanged and return -1.
+
+        void interleave(BasicSequence& other);
+        // Relink other's items in among this sequence's, so the items
+        // alternate starting with this sequence's first one and the longer
+        // one's extras come last.  other is left empty.
+
+        void merge(BasicSequence& other);
+        // Both sequences must be in order.  Relink other's items in among
+        // this sequence's, keeping it in order (with this sequence's items
+        // in front of equal ones from other).  other is left empty.
+
+        // Relinking needs the nodes to come from one pool.  If other's pool
+        // is its own, this sequence's pool adopts it (without allocating);
+        // if it is shared with sequences this one doesn't share with, the
+        // items are moved into new nodes instead.
+
+        const Pool* node_pool() const;
+        // Return the pool this sequence's nodes come from, or nullptr if it
+        // hasn't needed one yet.
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator cbegin() const;
+        const_iterator cend() const;
+        // Bidirectional iterators over the items in order, so a whole
+        // traversal is linear.  They stay valid until their item is erased.
+
+        Cursor cursor() const;
+        // Return a Cursor for reading this sequence by position.
+
+        void dump(bool multidump = false) const;
     private:
+        // U is T for iterator and const T for const_iterator; an iterator
+        // converts to a const_iterator
+        template <typename U>
+        class Iterator
+        {
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = U*;
+                using reference = U&;
+
+                Iterator() : node(nullptr), seq(nullptr) {}
+                template <typename V, typename = typename std::enable_if<
+                    std::is_same<V, T>::value && !std::is_same<U, T>::value>::type>
+                Iterator(const Iterator<V>& other) : node(other.node), seq(other.seq) {}
+
+                reference operator*() const { return node->val; }
+                pointer operator->() const { return &node->val; }
+                Iterator& operator++()
+                {
+                    node = node->next;
+                    return *this;
+                }
+                Iterator operator++(int)
+                {
+                    Iterator old = *this;
+                    node = node->next;
+                    return old;
+                }
+                Iterator& operator--()
+                {
+                    node = node != nullptr ? node->prev : seq->tail;
+                    return *this;
+                }
+                Iterator operator--(int)
+                {
+                    Iterator old = *this;
+                    --*this;
+                    return old;
+                }
+                friend bool operator==(const Iterator& a, const Iterator& b) { return a.node == b.node; }
+                friend bool operator!=(const Iterator& a, const Iterator& b) { return a.node != b.node; }
+            private:
+                friend class BasicSequence;
+                template <typename> friend class Iterator;
+                Iterator(Node* node, const BasicSequence* seq) : node(node), seq(seq) {}
+                Node* node;                // nullptr at end()
+                const BasicSequence* seq;  // needed to step back from end()
+        };
+    public:
+        // Reads items by position, walking from whichever is nearest of the
+        // head, the tail and the item it last read, so reading through
+        // nearby positions in turn is O(1) per call.  A cursor belongs to
+        // one thread, but several threads may each read the same sequence
+        // through their own.  It may only be used while the sequence is
+        // unchanged since the cursor was made or last reset().
+        class Cursor
+        {
+            public:
+                explicit Cursor(const BasicSequence& seq) : seq(&seq), node(nullptr), node_pos(0) {}
+                bool get(int pos, T& value);
+                // As for BasicSequence::get
+                void reset() { node = nullptr; }
+            private:
+                const BasicSequence* seq;
+                Node* node;    // item last read, or nullptr
+                int node_pos;  // its position
+        };
+    private:
+
         class Node
         {
             public: 
-                Node(ItemType val, Node* prev = nullptr, Node* next = nullptr);
-                ItemType val;
+                template <typename... Args>
+                Node(Node* prev, Node* next, Args&&... args)
+                    : val(std::forward<Args>(args)...), prev(prev), next(next) {}
+                T val;
                 Node* prev;
                 Node* next;
         };
+        template <typename... Args>
+        Node* create_node(Node* prev, Node* next, Args&&... args);
+        void destroy_node(Node* node);
         void reset_sequence();
-        void fill_sequence(const Sequence& other);
+        void fill_sequence(const BasicSequence& other);
+        int insert_position(const T& value) const;
         Node* delete_head();
         Node* delete_node(Node* node);
+        Node* node_at(int pos, Node* hint, int hint_pos) const;
+        Node* seek(int pos);
+        bool adopt_nodes(BasicSequence& other);
+        void take_nodes(BasicSequence& other, Node*& first, Node*& last);
         int num_items;
         Node* head;
+        Node* tail;
+        Node* finger;    // node last changed by position, or nullptr
+        int finger_pos;  // its position
+        Pool* pool;      // where nodes come from; made on first use if null
+        std::unique_ptr<Pool> own_pool;  // pool, if this sequence made it
 };
 
+using Sequence = BasicSequence<ItemType>;
+
 int subsequence(const Sequence& seq1, const Sequence& seq2);
+// Return the position of the first place seq2 occurs in seq1 as a
+// contiguous run, or -1 if it doesn't (or either is empty).  Linear time.
+
+template <typename T>
+std::vector<int> subsequences(const BasicSequence<T>& seq1, const BasicSequence<T>& seq2, int limit = -1);
+// Return the positions of every place seq2 occurs in seq1, in order,
+// including overlapping ones, or just the first limit of them if limit
+// isn't negative.  Linear time.
 
 void interleave(const Sequence& seq1, const Sequence& seq2, Sequence& result);
+// Set result to the items of seq1 and seq2 alternating, starting with
+// seq1's, with the longer one's extras at the end.  When seq1 and seq2 can
+// be consumed, seq1.interleave(seq2) does the same with no copying or
+// allocation.
+
+// Member function definitions; a template's have to be in its header
+
+template <typename T>
+void BasicSequence<T>::fill_sequence(const BasicSequence& other)
+{
+    num_items = other.num_items;
+    head = tail = nullptr;
+    finger = nullptr;
+    if(num_items > 0)
+    {
+        // A fresh pool gets all of the nodes in one allocation
+        if(pool == nullptr)
+        {
+            own_pool = std::make_unique<Pool>(num_items);
+            pool = own_pool.get();
+        }
+        Node* other_iter = other.head;
+        head = create_node(nullptr, nullptr, other.head->val);
+        Node* iter = head;
+        while(other_iter->next != nullptr)
+        {
+            iter->next = create_node(iter, nullptr, other_iter->next->val);
+            iter = iter->next;
+            other_iter = other_iter->next;
+        }
+        tail = iter;
+    }
+}
+
+template <typename T>
+template <typename... Args>
+typename BasicSequence<T>::Node* BasicSequence<T>::create_node(Node* prev, Node* next, Args&&... args)
+{
+    if(pool == nullptr)
+    {
+        own_pool = std::make_unique<Pool>();
+        pool = own_pool.get();
+    }
+    void* p = pool->allocate();
+    try
+    {
+        return new (p) Node(prev, next, std::forward<Args>(args)...);
+    }
+    catch(...)
+    {
+        pool->deallocate(p);
+        throw;
+    }
+}
+
+template <typename T>
+void BasicSequence<T>::destroy_node(Node* node)
+{
+    node->~Node();
+    pool->deallocate(node);
+}
+
+template <typename T>
+void BasicSequence<T>::reset_sequence()
+{
+    if(num_items > 0)
+    {
+        if(own_pool)
+        {
+            // Nobody else uses our pool, so once the items are destroyed
+            // all of its memory can be taken back at once
+            if(!std::is_trivially_destructible<T>::value)
+            {
+                for(Node* iter = head; iter != nullptr; iter = iter->next)
+                    iter->val.~T();
+            }
+            pool->clear();
+        }
+        else
+        {
+            Node* iter = head;
+            while(iter != nullptr)
+            {
+                Node* tmp = iter->next;
+                destroy_node(iter);
+                iter = tmp;
+            }
+        }
+    }
+}
+
+template <typename T>
+BasicSequence<T>::BasicSequence() 
+{
+    num_items = 0;
+    head = tail = nullptr;
+    finger = nullptr;
+    finger_pos = 0;
+    pool = nullptr;
+}
+
+template <typename T>
+BasicSequence<T>::BasicSequence(Pool& pool)
+{
+    num_items = 0;
+    head = tail = nullptr;
+    finger = nullptr;
+    finger_pos = 0;
+    this->pool = &pool;
+}
+
+template <typename T>
+BasicSequence<T>::BasicSequence(const BasicSequence& other)
+{
+    // The copy gets a pool of its own
+    pool = nullptr;
+    this->fill_sequence(other);
+}
+
+template <typename T>
+BasicSequence<T>::BasicSequence(BasicSequence&& other) noexcept
+{
+    // Take other's nodes and the pool they belong to, leaving it empty
+    num_items = other.num_items;
+    head = other.head;
+    tail = other.tail;
+    finger = other.finger;
+    finger_pos = other.finger_pos;
+    pool = other.pool;
+    own_pool = std::move(other.own_pool);
+    other.num_items = 0;
+    other.head = other.tail = nullptr;
+    other.finger = nullptr;
+    other.pool = nullptr;
+}
+
+template <typename T>
+BasicSequence<T>::~BasicSequence()
+{
+    this->reset_sequence();
+}
+
+template <typename T>
+BasicSequence<T>& BasicSequence<T>::operator=(const BasicSequence& other)
+{
+    if(this == &other)
+        return *this;
+    this->reset_sequence();
+    this->fill_sequence(other);
+    return *this;
+}
+
+template <typename T>
+BasicSequence<T>& BasicSequence<T>::operator=(BasicSequence&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    this->reset_sequence();
+    num_items = other.num_items;
+    head = other.head;
+    tail = other.tail;
+    finger = other.finger;
+    finger_pos = other.finger_pos;
+    pool = other.pool;
+    own_pool = std::move(other.own_pool);
+    other.num_items = 0;
+    other.head = other.tail = nullptr;
+    other.finger = nullptr;
+    other.pool = nullptr;
+    return *this;
+}
+
+template <typename T>
+bool BasicSequence<T>::empty() const
+{
+    return num_items == 0;
+}
+
+template <typename T>
+int BasicSequence<T>::size() const
+{
+    return num_items;
+}
+
+template <typename T>
+template <typename... Args>
+int BasicSequence<T>::emplace(int pos, Args&&... args)
+{
+    if(pos < 0 || pos > num_items)
+        return -1;
+    // Special case for replacing the head node
+    if(pos == 0)
+    {
+        Node* tmp = head;
+        head = create_node(nullptr, tmp, std::forward<Args>(args)...);
+        if(tmp != nullptr)
+            tmp->prev = head;
+        else
+            tail = head;
+        num_items++;
+        finger = head;
+        finger_pos = 0;
+        return 0;
+    }
+    // Find preceding spot (we will insert into the next spot)
+    Node* iter = this->seek(pos - 1);
+    // Insert new node into the next position
+    Node* tmp = iter->next;
+    iter->next = create_node(iter, tmp, std::forward<Args>(args)...);
+    if(tmp != nullptr)
+        tmp->prev = iter->next;
+    else
+        tail = iter->next;
+    num_items++;
+    finger = iter->next;
+    finger_pos = pos;
+    return pos;
+}
+
+template <typename T>
+int BasicSequence<T>::insert(int pos, const T& value)
+{
+    return this->emplace(pos, value);
+}
+
+template <typename T>
+int BasicSequence<T>::insert(int pos, T&& value)
+{
+    return this->emplace(pos, std::move(value));
+}
+
+template <typename T>
+int BasicSequence<T>::insert_position(const T& value) const
+{
+    // Determine where to insert
+    int p = 0;
+    Node* iter = head;
+    for( ; p < num_items; p++)
+    {
+        if(value <= iter->val)
+            break;
+        iter = iter->next;
+    }
+    return p;
+}
+
+template <typename T>
+int BasicSequence<T>::insert(const T& value)
+{
+    return this->emplace(this->insert_position(value), value);
+}
+
+template <typename T>
+int BasicSequence<T>::insert(T&& value)
+{
+    int p = this->insert_position(value);
+    return this->emplace(p, std::move(value));
+}
+
+template <typename T>
+typename BasicSequence<T>::Node* BasicSequence<T>::delete_head()
+{
+    Node* tmp = head->next;
+    if(tmp != nullptr)
+        tmp->prev = nullptr;
+    else
+        tail = nullptr;
+    destroy_node(head);
+    head = tmp;
+    num_items--;
+    return tmp;    
+}
+
+template <typename T>
+typename BasicSequence<T>::Node* BasicSequence<T>::delete_node(Node* node)
+{
+    Node* tmp = node->next;
+    if(node->prev != nullptr)
+        node->prev->next = node->next;
+    if(node->next != nullptr)
+        node->next->prev = node->prev;
+    else
+        tail = node->prev;
+    destroy_node(node);
+    num_items--;
+    return tmp;
+}
+
+template <typename T>
+bool BasicSequence<T>::erase(int pos)
+{
+    if(pos < 0 || pos >= num_items)
+        return false;
+    Node* iter = this->seek(pos);
+    Node* next = iter->next;
+    Node* prev = iter->prev;
+    // Erase item
+    if(pos == 0)
+        this->delete_head();
+    else
+        this->delete_node(iter);
+    // Move the finger off the erased node to a neighbour
+    if(next != nullptr)
+        finger = next;
+    else
+    {
+        finger = prev;
+        finger_pos = pos - 1;
+    }
+    return true;
+}
+
+template <typename T>
+int BasicSequence<T>::remove(const T& value)
+{
+    finger = nullptr;
+    int ctr = 0, i = 0;
+    Node* iter = head;
+    while(i < num_items)
+    {
+        if( iter->val == value)
+        {
+            ctr++;
+            if(i == 0)
+            {
+                iter = this->delete_head();
+            }
+            else
+            {   
+                iter = this->delete_node(iter);
+            }
+        }
+        else
+        {
+            i++;
+            iter = iter->next;
+        }
+    }
+    return ctr;
+}
+
+template <typename T>
+bool BasicSequence<T>::get(int pos, T& value) const
+{
+    if(pos < 0 || pos >= num_items)
+        return false;
+    value = this->node_at(pos, finger, finger_pos)->val;
+    return true;
+}
+
+template <typename T>
+bool BasicSequence<T>::set(int pos, const T& value)
+{
+    if(pos < 0 || pos >= num_items)
+        return false;
+    this->seek(pos)->val = value;
+    return true;
+}
+
+template <typename T>
+int BasicSequence<T>::find(const T& value) const
+{
+    int p = -1;
+    Node* iter = head;
+    for(int i = 0; i < num_items; i++)
+    {
+        if(iter->val == value)
+        {
+            p = i;
+            break;
+        }
+        iter = iter->next;
+    }
+    return p;
+}
+
+template <typename T>
+void BasicSequence<T>::swap(BasicSequence& other)
+{
+    // Nodes have to go back to the pool they came from, so the pools are
+    // exchanged along with them
+    Node* head_tmp = this->head;
+    Node* tail_tmp = this->tail;
+    Node* finger_tmp = this->finger;
+    int finger_pos_tmp = this->finger_pos;
+    int num_items_tmp = this->num_items;
+    Pool* pool_tmp = this->pool;
+
+    head = other.head;
+    tail = other.tail;
+    finger = other.finger;
+    finger_pos = other.finger_pos;
+    num_items = other.num_items;
+    pool = other.pool;
+    own_pool.swap(other.own_pool);
+
+    other.head = head_tmp;
+    other.tail = tail_tmp;
+    other.finger = finger_tmp;
+    other.finger_pos = finger_pos_tmp;
+    other.num_items = num_items_tmp;
+    other.pool = pool_tmp;
+}
+
+template <typename T>
+typename BasicSequence<T>::Node* BasicSequence<T>::node_at(int pos, Node* hint, int hint_pos) const
+{
+    // Walk from whichever of the head, the tail and hint (if it isn't null)
+    // is nearest
+    Node* iter = head;
+    int at = 0;
+    if(num_items - 1 - pos < pos)
+    {
+        iter = tail;
+        at = num_items - 1;
+    }
+    if(hint != nullptr && std::abs(hint_pos - pos) < std::abs(at - pos))
+    {
+        iter = hint;
+        at = hint_pos;
+    }
+    for( ; at < pos; at++)
+        iter = iter->next;
+    for( ; at > pos; at--)
+        iter = iter->prev;
+    return iter;
+}
+
+template <typename T>
+typename BasicSequence<T>::Node* BasicSequence<T>::seek(int pos)
+{
+    // Find the node at pos and leave the finger there
+    finger = this->node_at(pos, finger, finger_pos);
+    finger_pos = pos;
+    return finger;
+}
+
+template <typename T>
+bool BasicSequence<T>::Cursor::get(int pos, T& value)
+{
+    if(pos < 0 || pos >= seq->num_items)
+        return false;
+    // Until it has read something, start from the sequence's finger
+    Node* hint = node != nullptr ? node : seq->finger;
+    int hint_pos = node != nullptr ? node_pos : seq->finger_pos;
+    node = seq->node_at(pos, hint, hint_pos);
+    node_pos = pos;
+    value = node->val;
+    return true;
+}
+
+template <typename T>
+typename BasicSequence<T>::Cursor BasicSequence<T>::cursor() const
+{
+    return Cursor(*this);
+}
+
+template <typename T>
+template <typename InputIt>
+void BasicSequence<T>::append(InputIt first, InputIt last)
+{
+    for( ; first != last; ++first)
+    {
+        Node* node = create_node(tail, nullptr, *first);
+        if(tail != nullptr)
+            tail->next = node;
+        else
+            head = node;
+        tail = node;
+        num_items++;
+    }
+}
+
+template <typename T>
+bool BasicSequence<T>::adopt_nodes(BasicSequence& other)
+{
+    // Return true if other's nodes can now be given back to our pool
+    if(other.pool == pool)
+        return true;
+    // A pool other shares can't become ours, since whoever supplied it may
+    // destroy it before we're done with the nodes
+    if(!other.own_pool)
+        return false;
+    if(pool == nullptr)
+    {
+        // We have no nodes, so just take over other's pool
+        own_pool = std::move(other.own_pool);
+        pool = other.pool;
+        other.pool = nullptr;
+    }
+    else
+        pool->adopt(*other.pool);
+    return true;
+}
+
+template <typename T>
+void BasicSequence<T>::take_nodes(BasicSequence& other, Node*& first, Node*& last)
+{
+    // Set first and last to the ends of a chain holding other's items in
+    // nodes from our pool, leaving other empty
+    if(this->adopt_nodes(other))
+    {
+        first = other.head;
+        last = other.tail;
+    }
+    else
+    {
+        first = last = nullptr;
+        try
+        {
+            for(Node* iter = other.head; iter != nullptr; iter = iter->next)
+            {
+                Node* node = create_node(last, nullptr, std::move(iter->val));
+                if(last != nullptr)
+                    last->next = node;
+                else
+                    first = node;
+                last = node;
+            }
+        }
+        catch(...)
+        {
+            while(first != nullptr)
+            {
+                Node* tmp = first->next;
+                destroy_node(first);
+                first = tmp;
+            }
+            throw;
+        }
+        other.reset_sequence();
+    }
+    other.head = other.tail = nullptr;
+    other.finger = nullptr;
+    other.num_items = 0;
+}
+
+template <typename T>
+int BasicSequence<T>::splice(int pos, BasicSequence& other)
+{
+    if(pos < 0 || pos > num_items || &other == this)
+        return -1;
+    if(other.num_items == 0)
+        return pos;
+    int n = other.num_items;
+    Node* first;
+    Node* last;
+    this->take_nodes(other, first, last);
+    // Link the chain in between before and after
+    Node* before = pos == 0 ? nullptr : this->seek(pos - 1);
+    Node* after = before == nullptr ? head : before->next;
+    first->prev = before;
+    last->next = after;
+    if(before != nullptr)
+        before->next = first;
+    else
+        head = first;
+    if(after != nullptr)
+        after->prev = last;
+    else
+        tail = last;
+    num_items += n;
+    if(finger != nullptr && finger_pos >= pos)
+        finger_pos += n;
+    return pos;
+}
+
+template <typename T>
+void BasicSequence<T>::interleave(BasicSequence& other)
+{
+    if(&other == this || other.num_items == 0)
+        return;
+    int n = other.num_items;
+    Node* first;
+    Node* last;
+    this->take_nodes(other, first, last);
+    num_items += n;
+    finger = nullptr;
+    if(head == nullptr)
+    {
+        head = first;
+        tail = last;
+        return;
+    }
+    // Put each of other's nodes after the corresponding one of ours
+    Node* a = head;
+    Node* b = first;
+    while(a != nullptr && b != nullptr)
+    {
+        Node* a_next = a->next;
+        Node* b_next = b->next;
+        a->next = b;
+        b->prev = a;
+        if(a_next == nullptr)
+        {
+            // We ran out first; the rest of other's chain is already after b
+            tail = last;
+            return;
+        }
+        b->next = a_next;
+        a_next->prev = b;
+        a = a_next;
+        b = b_next;
+    }
+}
+
+template <typename T>
+void BasicSequence<T>::merge(BasicSequence& other)
+{
+    if(&other == this || other.num_items == 0)
+        return;
+    int n = other.num_items;
+    Node* first;
+    Node* last;
+    this->take_nodes(other, first, last);
+    num_items += n;
+    finger = nullptr;
+    // Repeatedly move the smaller front node onto the end of the result
+    Node* a = head;
+    Node* b = first;
+    Node* result_head = nullptr;
+    Node* result_tail = nullptr;
+    while(a != nullptr && b != nullptr)
+    {
+        Node* node;
+        if(a->val <= b->val)
+        {
+            node = a;
+            a = a->next;
+        }
+        else
+        {
+            node = b;
+            b = b->next;
+        }
+        node->prev = result_tail;
+        if(result_tail != nullptr)
+            result_tail->next = node;
+        else
+            result_head = node;
+        result_tail = node;
+    }
+    // Whatever is left is already in order
+    Node* rest = a != nullptr ? a : b;
+    rest->prev = result_tail;
+    if(result_tail != nullptr)
+        result_tail->next = rest;
+    else
+        result_head = rest;
+    head = result_head;
+    if(b != nullptr)
+        tail = last;
+}
+
+template <typename T>
+const typename BasicSequence<T>::Pool* BasicSequence<T>::node_pool() const
+{
+    return pool;
+}
+
+template <typename T>
+typename BasicSequence<T>::iterator BasicSequence<T>::begin()
+{
+    return iterator(head, this);
+}
+
+template <typename T>
+typename BasicSequence<T>::iterator BasicSequence<T>::end()
+{
+    return iterator(nullptr, this);
+}
+
+template <typename T>
+typename BasicSequence<T>::const_iterator BasicSequence<T>::begin() const
+{
+    return const_iterator(head, this);
+}
+
+template <typename T>
+typename BasicSequence<T>::const_iterator BasicSequence<T>::end() const
+{
+    return const_iterator(nullptr, this);
+}
+
+template <typename T>
+typename BasicSequence<T>::const_iterator BasicSequence<T>::cbegin() const
+{
+    return begin();
+}
+
+template <typename T>
+typename BasicSequence<T>::const_iterator BasicSequence<T>::cend() const
+{
+    return end();
+}
+
+template <typename T>
+void BasicSequence<T>::dump(bool multidump) const
+{
+    std::cerr << "DUMPING: \n";
+    for(const T& val : *this)
+        std::cerr << val << " ";
+    std::cerr << std::endl;
+    if(multidump)
+    {
+        for(auto iter = std::make_reverse_iterator(end()); iter != std::make_reverse_iterator(begin()); ++iter)
+            std::cerr << *iter << " ";
+        std::cerr << std::endl;
+    }
+}
+
+// Knuth-Morris-Pratt search for a pattern of pattern_size items, where
+// pattern(j) is the item at position j, in the items from first up to last.
+// Return the positions where it occurs, in order, or just the first limit
+// of them if limit isn't negative.  Each item of the text is compared at
+// most twice on average, so this is O(n + m).  Items are only compared
+// with ==.  Every sequence's subsequence search is this one.
+template <typename ForwardIt, typename Pattern>
+std::vector<int> find_runs(ForwardIt first, ForwardIt last, const Pattern& pattern, int pattern_size, int limit = -1)
+{
+    std::vector<int> matches;
+    if(pattern_size <= 0 || limit == 0)
+        return matches;
+    // border[j] is the length of the longest proper prefix of
+    // pattern[0..j] that is also a suffix of it
+    std::vector<int> border(pattern_size, 0);
+    for(int j = 1, k = 0; j < pattern_size; j++)
+    {
+        while(k > 0 && !(pattern(j) == pattern(k)))
+            k = border[k - 1];
+        if(pattern(j) == pattern(k))
+            k++;
+        border[j] = k;
+    }
+    // Scan the text once; k is how much of the pattern currently matches
+    int pos = 0, k = 0;
+    for( ; first != last; ++first)
+    {
+        while(k > 0 && !(*first == pattern(k)))
+            k = border[k - 1];
+        if(*first == pattern(k))
+            k++;
+        if(k == pattern_size)
+        {
+            matches.push_back(pos - pattern_size + 1);
+            if((int) matches.size() == limit)
+                break;
+            k = border[k - 1];
+        }
+        pos++;
+    }
+    return matches;
+}
+
+template <typename T>
+std::vector<int> subsequences(const BasicSequence<T>& seq1, const BasicSequence<T>& seq2, int limit)
+{
+    int size1 = seq1.size(), size2 = seq2.size();
+    if(size1 == 0 || size2 == 0 || size2 > size1)
+        return std::vector<int>();
+    // The pattern is looked up by position, so point at its items
+    std::vector<const T*> pattern;
+    pattern.reserve(size2);
+    for(const T& item : seq2)
+        pattern.push_back(&item);
+    return find_runs(seq1.begin(), seq1.end(), [&pattern](int j) -> const T& { return *pattern[j]; }, size2, limit);
+}
 
 #endif
\ No newline at end of file
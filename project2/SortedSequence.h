@@ -0,0 +1,384 @@
+#ifndef SORTEDSEQUENCE
+#define SORTEDSEQUENCE
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// A sequence that is always in order, for large sequences that are only
+// ever added to with the ordered insert.  It behaves like a Sequence built
+// that way, including where duplicates go, but it is an indexable skip
+// list: each node also has links that skip ahead, each knowing how many
+// positions it skips, so inserting, finding and removing by value and
+// getting or erasing by position all take O(log n) expected time.
+// T only needs <= and ==, as for Sequence.
+template <typename T>
+class SortedSequence
+{
+    private:
+        class Node;
+    public:
+        SortedSequence();    // Create an empty sequence
+        SortedSequence(const SortedSequence& other);
+        SortedSequence(SortedSequence&& other) noexcept;
+        ~SortedSequence();
+        SortedSequence& operator=(const SortedSequence& other);
+        SortedSequence& operator=(SortedSequence&& other) noexcept;
+        bool empty() const;  // Return true if the sequence is empty, otherwise false.
+        int size() const;    // Return the number of items in the sequence.
+
+        int insert(const T& value);
+        // Let p be the smallest integer such that value <= the item at
+        // position p (or size() if there is none), insert value so it
+        // becomes the item at position p, and return p.  So a value equal
+        // to items already there goes before them.
+
+        bool erase(int pos);
+        // If 0 <= pos < size(), remove the item at position pos and return
+        // true.  Otherwise, leave the sequence unchanged and return false.
+
+        int remove(const T& value);
+        // Erase all items that == value.  Return the number removed.
+
+        bool get(int pos, T& value) const;
+        // If 0 <= pos < size(), copy into value the item at position pos
+        // and return true.  Otherwise, leave value unchanged and return false.
+
+        int find(const T& value) const;
+        // Return the smallest p such that value == the item at position p,
+        // or -1 if there is none.
+
+        void swap(SortedSequence& other);
+        // Exchange the contents of this sequence with the other one.
+
+        class const_iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+
+                const_iterator() : node(nullptr) {}
+                reference operator*() const { return node->val; }
+                pointer operator->() const { return &node->val; }
+                const_iterator& operator++()
+                {
+                    node = node->links[0].next;
+                    return *this;
+                }
+                const_iterator operator++(int)
+                {
+                    const_iterator old = *this;
+                    node = node->links[0].next;
+                    return old;
+                }
+                friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.node == b.node; }
+                friend bool operator!=(const const_iterator& a, const const_iterator& b) { return a.node != b.node; }
+            private:
+                friend class SortedSequence;
+                explicit const_iterator(Node* node) : node(node) {}
+                Node* node;  // nullptr at end()
+        };
+        const_iterator begin() const;
+        const_iterator end() const;
+        // Forward iterators over the items in order.  Items can't be changed
+        // through them, since that could put the sequence out of order.
+
+    private:
+        static const int MAX_LEVEL = 32;
+        struct Link
+        {
+            Node* next;  // next node at this level, or nullptr
+            int width;   // how many positions it is ahead; unused if next is nullptr
+        };
+        class Node
+        {
+            public:
+                Node(const T& val, int level) : val(val), links(level) {}
+                T val;
+                std::vector<Link> links;  // links[0] is the plain linked list
+        };
+        int random_level();
+        int lower_bound(const T& value, Link** update, int* rank) const;
+        int find_position(int pos, Link** update) const;
+        void unlink(Node* node, Link** update);
+        void reset_sequence();
+        void fill_sequence(const SortedSequence& other);
+        int num_items;
+        int level;                // number of levels in use
+        std::vector<Link> head;   // MAX_LEVEL links in front of the first item
+        uint64_t random_state;    // for choosing the levels of new nodes
+};
+
+template <typename T>
+SortedSequence<T>::SortedSequence()
+ : head(MAX_LEVEL, Link{nullptr, 0})
+{
+    num_items = 0;
+    level = 1;
+    random_state = 0x9E3779B97F4A7C15ULL;
+}
+
+template <typename T>
+SortedSequence<T>::SortedSequence(const SortedSequence& other)
+ : SortedSequence()
+{
+    this->fill_sequence(other);
+}
+
+template <typename T>
+SortedSequence<T>::SortedSequence(SortedSequence&& other) noexcept
+ : SortedSequence()
+{
+    this->swap(other);
+}
+
+template <typename T>
+SortedSequence<T>::~SortedSequence()
+{
+    this->reset_sequence();
+}
+
+template <typename T>
+SortedSequence<T>& SortedSequence<T>::operator=(const SortedSequence& other)
+{
+    if(this == &other)
+        return *this;
+    SortedSequence tmp(other);
+    this->swap(tmp);
+    return *this;
+}
+
+template <typename T>
+SortedSequence<T>& SortedSequence<T>::operator=(SortedSequence&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    this->reset_sequence();
+    this->swap(other);
+    return *this;
+}
+
+template <typename T>
+void SortedSequence<T>::reset_sequence()
+{
+    Node* iter = head[0].next;
+    while(iter != nullptr)
+    {
+        Node* tmp = iter->links[0].next;
+        delete iter;
+        iter = tmp;
+    }
+    for(Link& link : head)
+        link = Link{nullptr, 0};
+    num_items = 0;
+    level = 1;
+}
+
+template <typename T>
+void SortedSequence<T>::fill_sequence(const SortedSequence& other)
+{
+    // Inserting the items last to first puts each one in front of any
+    // equal items, which keeps them in the same order as in other
+    std::vector<const T*> items;
+    items.reserve(other.num_items);
+    for(const T& item : other)
+        items.push_back(&item);
+    for(int i = (int) items.size() - 1; i >= 0; i--)
+        this->insert(*items[i]);
+}
+
+template <typename T>
+bool SortedSequence<T>::empty() const
+{
+    return num_items == 0;
+}
+
+template <typename T>
+int SortedSequence<T>::size() const
+{
+    return num_items;
+}
+
+template <typename T>
+int SortedSequence<T>::random_level()
+{
+    // xorshift64; each level is used with a quarter of the probability of
+    // the one below it
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    uint64_t bits = random_state;
+    int lvl = 1;
+    while(lvl < MAX_LEVEL && (bits & 3) == 0)
+    {
+        lvl++;
+        bits >>= 2;
+    }
+    return lvl;
+}
+
+template <typename T>
+int SortedSequence<T>::lower_bound(const T& value, Link** update, int* rank) const
+{
+    // At each level, go as far as possible while staying in front of every
+    // item >= value; update[i] is the link we stopped at, and rank[i] the
+    // number of items before the node it belongs to
+    Link* links = const_cast<Link*>(head.data());
+    int pos = 0;
+    for(int i = level - 1; i >= 0; i--)
+    {
+        while(links[i].next != nullptr && !(value <= links[i].next->val))
+        {
+            pos += links[i].width;
+            links = links[i].next->links.data();
+        }
+        update[i] = &links[i];
+        rank[i] = pos;
+    }
+    return pos;
+}
+
+template <typename T>
+int SortedSequence<T>::find_position(int pos, Link** update) const
+{
+    // Like lower_bound, but stopping in front of the item at position pos
+    Link* links = const_cast<Link*>(head.data());
+    int reached = 0;
+    for(int i = level - 1; i >= 0; i--)
+    {
+        while(links[i].next != nullptr && reached + links[i].width <= pos)
+        {
+            reached += links[i].width;
+            links = links[i].next->links.data();
+        }
+        update[i] = &links[i];
+    }
+    return reached;
+}
+
+template <typename T>
+void SortedSequence<T>::unlink(Node* node, Link** update)
+{
+    // update[i] are the links in front of node, as found by lower_bound
+    // or find_position
+    for(int i = 0; i < level; i++)
+    {
+        if(update[i]->next == node)
+        {
+            update[i]->width += node->links[i].width - 1;
+            update[i]->next = node->links[i].next;
+        }
+        else
+            update[i]->width--;
+    }
+    delete node;
+    num_items--;
+    while(level > 1 && head[level - 1].next == nullptr)
+        level--;
+}
+
+template <typename T>
+int SortedSequence<T>::insert(const T& value)
+{
+    Link* update[MAX_LEVEL] = {};
+    int rank[MAX_LEVEL];
+    int p = this->lower_bound(value, update, rank);
+    int lvl = this->random_level();
+    for( ; level < lvl; level++)
+    {
+        update[level] = &head[level];
+        rank[level] = 0;
+    }
+    Node* node = new Node(value, lvl);
+    for(int i = 0; i < lvl; i++)
+    {
+        // Split the link in front of the new node around it
+        node->links[i].next = update[i]->next;
+        node->links[i].width = update[i]->width - (p - rank[i]);
+        update[i]->next = node;
+        update[i]->width = p - rank[i] + 1;
+    }
+    // Links that pass over the new node now skip one more position
+    for(int i = lvl; i < level; i++)
+        update[i]->width++;
+    num_items++;
+    return p;
+}
+
+template <typename T>
+bool SortedSequence<T>::erase(int pos)
+{
+    if(pos < 0 || pos >= num_items)
+        return false;
+    Link* update[MAX_LEVEL] = {};
+    this->find_position(pos, update);
+    this->unlink(update[0]->next, update);
+    return true;
+}
+
+template <typename T>
+int SortedSequence<T>::remove(const T& value)
+{
+    // Equal items are next to each other, starting at the lower bound
+    Link* update[MAX_LEVEL] = {};
+    int rank[MAX_LEVEL];
+    this->lower_bound(value, update, rank);
+    int ctr = 0;
+    while(update[0]->next != nullptr && update[0]->next->val == value)
+    {
+        this->unlink(update[0]->next, update);
+        ctr++;
+    }
+    return ctr;
+}
+
+template <typename T>
+bool SortedSequence<T>::get(int pos, T& value) const
+{
+    if(pos < 0 || pos >= num_items)
+        return false;
+    Link* update[MAX_LEVEL] = {};
+    this->find_position(pos, update);
+    value = update[0]->next->val;
+    return true;
+}
+
+template <typename T>
+int SortedSequence<T>::find(const T& value) const
+{
+    Link* update[MAX_LEVEL] = {};
+    int rank[MAX_LEVEL];
+    int p = this->lower_bound(value, update, rank);
+    Node* node = update[0]->next;
+    if(node != nullptr && node->val == value)
+        return p;
+    return -1;
+}
+
+template <typename T>
+void SortedSequence<T>::swap(SortedSequence& other)
+{
+    std::swap(num_items, other.num_items);
+    std::swap(level, other.level);
+    head.swap(other.head);
+    std::swap(random_state, other.random_state);
+}
+
+template <typename T>
+typename SortedSequence<T>::const_iterator SortedSequence<T>::begin() const
+{
+    return const_iterator(head[0].next);
+}
+
+template <typename T>
+typename SortedSequence<T>::const_iterator SortedSequence<T>::end() const
+{
+    return const_iterator(nullptr);
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef THREADPOOL
+#define THREADPOOL
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+  // A fixed set of threads that repeatedly run batches of tasks.  The threads
+  // are started once, so handing them a batch costs a wakeup rather than a
+  // thread creation.
+class ThreadPool
+{
+  public:
+        // Constructor/destructor
+    ThreadPool(int nThreads);
+    ~ThreadPool();
+
+        // Accessors
+    int size() const;
+
+        // Call task(k, worker) for every k from 0 to nTasks-1, spread over the
+        // pool's threads (the calling thread is worker 0), and return when all
+        // of them have finished.  worker is less than size(), and no two
+        // tasks with the same worker run at the same time.
+    void run(int nTasks, const std::function<void(int, int)>& task);
+
+  private:
+    std::vector<std::thread> m_threads;
+    std::mutex               m_lock;
+    std::condition_variable  m_wake;   // a new batch is ready, or stopping
+    std::condition_variable  m_done;   // the last helper finished a batch
+    const std::function<void(int, int)>* m_task;
+    int                      m_nTasks;
+    std::atomic<int>         m_nextTask;
+    int                      m_busy;        // helpers still on this batch
+    unsigned                 m_generation;  // number of batches started
+    bool                     m_stopping;
+
+      // Helper functions
+    void workerLoop(int worker);
+    void work(int worker);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Measures throughput of a shared sequence of 10^5 ints (or the size given
+// on the command line) used by 1 to N threads at once (N defaults to the
+// number of hardware threads).  Each thread does random operations for the
+// time limit.  Workloads:
+//   mixed      - gets, with every 10th operation a set
+//   read_only  - gets only, so any slowdown as threads are added comes from
+//                the readers themselves
+// "concurrent" is ConcurrentSequence; "locked" is a Sequence behind one
+// mutex, which is how shared sequences were used before; "shared_ptr"
+// (read only) picks up the version with std::atomic_load on a shared_ptr,
+// as ConcurrentSequence once did, which takes an internal lock and bumps a
+// shared count on every read; "snapshot" (read only) has each thread take
+// one snapshot and get from that, which is as fast as reads can scale.
+// concurrent read_only should track snapshot as threads are added, and
+// shared_ptr shouldn't.
+// Usage: benchConcurrentSequence [n] [maxThreads]
+#include "ConcurrentSequence.h"
+#include "Sequence.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+const double TIME_LIMIT = 0.5;  // seconds per measurement
+const int WRITE_EVERY = 10;     // one operation in this many is a set
+
+// A Sequence used the old way
+struct LockedSequence
+{
+    BasicSequence<int> seq;
+    mutable mutex m;
+    bool get(int pos, int& value) const
+    {
+        lock_guard<mutex> lock(m);
+        return seq.get(pos, value);
+    }
+    bool set(int pos, int value)
+    {
+        lock_guard<mutex> lock(m);
+        return seq.set(pos, value);
+    }
+};
+
+// Run nThreads threads doing op(thread, k) for k = 0, 1, ... until the time
+// limit, and print a CSV record
+template <typename Op>
+void measure(const string& impl, const string& workload, int n, int nThreads, Op op)
+{
+    atomic<bool> stop(false);
+    atomic<long> total(0);
+    vector<thread> threads;
+    auto start = chrono::steady_clock::now();
+    for(int t = 0; t < nThreads; t++)
+        threads.emplace_back([&, t]() {
+            long done = 0;
+            while(!stop.load(memory_order_relaxed))
+            {
+                op(t, done);
+                done++;
+            }
+            total += done;
+        });
+    this_thread::sleep_for(chrono::duration<double>(TIME_LIMIT));
+    stop = true;
+    for(thread& th : threads)
+        th.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << impl << "," << workload << "," << n << "," << nThreads << "," << total << ","
+         << total / secs << endl;
+}
+
+// A cheap per-thread random position
+int position(int t, long k, int n)
+{
+    uint64_t z = (uint64_t) k * 0x9E3779B97F4A7C15ULL + (uint64_t) t * 0xBF58476D1CE4E5B9ULL;
+    z ^= z >> 31;
+    return (int) (z % n);
+}
+
+int main(int argc, char* argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : (int) thread::hardware_concurrency();
+    if(maxThreads < 1)
+        maxThreads = 1;
+    cout << "impl,workload,n,threads,ops,ops_per_sec" << endl;
+
+    ConcurrentSequence<int> concurrent;
+    concurrent.update([n](PersistentSequence<int>& s) {
+        for(int i = 0; i < n; i++)
+            s.insert(i, i);
+    });
+    auto shared = make_shared<const PersistentSequence<int>>(concurrent.snapshot());
+    LockedSequence locked;
+    for(int i = 0; i < n; i++)
+        locked.seq.insert(i, i);
+
+    for(int threads = 1; threads <= maxThreads; threads++)
+    {
+        measure("concurrent", "mixed", n, threads, [&](int t, long k) {
+            int pos = position(t, k, n);
+            int value;
+            if(k % WRITE_EVERY == 0)
+                concurrent.set(pos, (int) k);
+            else
+                concurrent.get(pos, value);
+        });
+        measure("locked", "mixed", n, threads, [&](int t, long k) {
+            int pos = position(t, k, n);
+            int value;
+            if(k % WRITE_EVERY == 0)
+                locked.set(pos, (int) k);
+            else
+                locked.get(pos, value);
+        });
+        measure("concurrent", "read_only", n, threads, [&](int t, long k) {
+            int value;
+            concurrent.get(position(t, k, n), value);
+        });
+        measure("locked", "read_only", n, threads, [&](int t, long k) {
+            int value;
+            locked.get(position(t, k, n), value);
+        });
+        measure("shared_ptr", "read_only", n, threads, [&](int t, long k) {
+            int value;
+            atomic_load(&shared)->get(position(t, k, n), value);
+        });
+        vector<PersistentSequence<int>> snapshots(threads, concurrent.snapshot());
+        measure("snapshot", "read_only", n, threads, [&](int t, long k) {
+            int value;
+            snapshots[t].get(position(t, k, n), value);
+        });
+    }
+}
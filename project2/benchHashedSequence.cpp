@@ -0,0 +1,65 @@
+// Compares searching a Sequence of strings with searching a HashedSequence
+// of the same strings: n distinct 64-character keys (10^5 by default) that
+// share a 48-character prefix, so telling two keys apart with string's ==
+// means reading most of both.  Workloads:
+//   find_missing  - find a key that isn't there, so every item is compared
+//   remove_none   - remove a key that isn't there
+//   subsequences  - find every occurrence of a 3-item pattern that
+//                   occurs once
+// Each call is repeated until the time limit; ms_per_call is the average.
+// Usage: benchHashedSequence [n]
+#include "HashedString.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+using namespace std;
+
+const double TIME_LIMIT = 1.0;  // seconds per measurement
+
+// Call op until the time limit and print a CSV record
+template <typename Op>
+void measure(const string& impl, const string& workload, int n, Op op)
+{
+    long calls = 0;
+    int result = 0;
+    auto start = chrono::steady_clock::now();
+    double secs;
+    do
+    {
+        result = op();
+        calls++;
+        secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    } while(secs < TIME_LIMIT);
+    cout << impl << "," << workload << "," << n << "," << calls << ","
+         << secs * 1e3 / calls << "," << result << endl;
+}
+
+// The i-th key; the differing digits come last
+string key(int i)
+{
+    return string(48, 'k') + to_string(1000000000000000LL + i);
+}
+
+// Run the workloads on a sequence of type Seq
+template <typename Seq>
+void run(const string& impl, int n)
+{
+    Seq s, pattern;
+    for(int i = 0; i < n; i++)
+        s.insert(i, key(i));
+    for(int i = 0; i < 3; i++)
+        pattern.insert(i, key(n / 2 + i));
+    const string missing = key(n);
+    measure(impl, "find_missing", n, [&]() { return s.find(missing); });
+    measure(impl, "remove_none", n, [&]() { return s.remove(missing); });
+    measure(impl, "subsequences", n, [&]() { return (int) subsequences(s, pattern).size(); });
+}
+
+int main(int argc, char* argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 100000;
+    cout << "impl,workload,n,calls,ms_per_call,result" << endl;
+    run<Sequence>("string", n);
+    run<HashedSequence>("hashed", n);
+}
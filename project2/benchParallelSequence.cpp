@@ -0,0 +1,71 @@
+// Compares the serial scans of ArraySequence with the parallel ones, on
+// 2*10^6 distinct 40-character strings (or the size given on the command
+// line), for thread pools of 1 to N threads (N defaults to the number of
+// hardware threads).  Workloads:
+//   find_missing - find a value that isn't there, so the whole array is read
+//   count        - count a value that appears once in every 100 items
+//   remove       - remove that value, on a fresh copy each time
+// threads is 0 for the serial version; there is no serial count, so that
+// goes through get(), as callers had to before.
+// Usage: benchParallelSequence [n] [maxThreads]
+#include "ArraySequence.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+using namespace std;
+
+// Time op once and print a CSV record
+template <typename Op>
+void measure(const string& workload, int threads, int n, Op op)
+{
+    auto start = chrono::steady_clock::now();
+    int result = op();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << workload << "," << threads << "," << n << "," << secs * 1e3 << ","
+         << result << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 2000000;
+    int maxThreads = argc > 2 ? atoi(argv[2]) : (int) thread::hardware_concurrency();
+    if(maxThreads < 1)
+        maxThreads = 1;
+    cout << "workload,threads,n,ms,result" << endl;
+
+    // Long keys sharing a prefix, so comparing them means reading them
+    const string prefix(30, 'k');
+    const string common = prefix + "-common--";
+    ArraySequence s;
+    s.reserve(n);
+    for(int i = 0; i < n; i++)
+        s.insert(i, i % 100 == 0 ? common : prefix + to_string(1000000000 + i));
+
+    measure("find_missing", 0, n, [&]() { return s.find(prefix + "missing"); });
+    measure("count", 0, n, [&]() {
+        int ctr = 0;
+        ItemType x;
+        for(int i = 0; i < s.size(); i++)
+        {
+            s.get(i, x);
+            if(x == common)
+                ctr++;
+        }
+        return ctr;
+    });
+    {
+        ArraySequence copy(s);
+        measure("remove", 0, n, [&]() { return copy.remove(common); });
+    }
+    for(int threads = 1; threads <= maxThreads; threads++)
+    {
+        ThreadPool pool(threads);
+        measure("find_missing", threads, n, [&]() { return s.parallel_find(prefix + "missing", pool); });
+        measure("count", threads, n, [&]() { return s.parallel_count(common, pool); });
+        ArraySequence copy(s);
+        measure("remove", threads, n, [&]() { return copy.parallel_remove(common, pool); });
+    }
+}
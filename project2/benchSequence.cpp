@@ -0,0 +1,148 @@
+// Compares the linked-list Sequence with ArraySequence on sequences of
+// 10^6 strings (or the size given on the command line).  Each workload
+// runs until it has done n operations or used its time limit, so the
+// quadratic cases finish; ns_per_op and heap_allocs_per_op (calls to
+// operator new) are over the operations actually done.
+// Usage: benchSequence [n]
+#include "Sequence.h"
+#include "ArraySequence.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+using namespace std;
+
+const double TIME_LIMIT = 1.0;  // seconds per workload
+
+// Count every heap allocation the program makes
+long heapAllocs = 0;
+
+void* operator new(size_t size)
+{
+    heapAllocs++;
+    void* p = malloc(size == 0 ? 1 : size);
+    if(p == nullptr)
+        throw bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+// Items are "item0", "item1", ...; build the fastest way for each kind
+void build(Sequence& s, int n)
+{
+    for(int i = n - 1; i >= 0; i--)
+        s.insert(0, "item" + to_string(i));
+}
+
+void build(ArraySequence& s, int n)
+{
+    s.reserve(n);
+    for(int i = 0; i < n; i++)
+        s.insert(i, "item" + to_string(i));
+}
+
+// Something to read s by position through: a Cursor for a Sequence, whose
+// get() doesn't move its finger, and the sequence itself otherwise
+Sequence::Cursor reader(const Sequence& s)
+{
+    return s.cursor();
+}
+
+const ArraySequence& reader(const ArraySequence& s)
+{
+    return s;
+}
+
+// Run op(k) for k = 0, 1, ... until nOps have run or time is up, and print
+// a CSV record
+template <typename Op>
+void measure(const string& impl, const string& workload, int n, long nOps, Op op)
+{
+    long allocsBefore = heapAllocs;
+    auto start = chrono::steady_clock::now();
+    long done = 0;
+    double secs = 0;
+    while(done < nOps)
+    {
+        op(done);
+        done++;
+        if(done % 64 == 0)
+        {
+            secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            if(secs > TIME_LIMIT)
+                break;
+        }
+    }
+    secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << impl << "," << workload << "," << n << "," << done << ","
+         << secs * 1e9 / done << ","
+         << double(heapAllocs - allocsBefore) / done << endl;
+}
+
+template <typename Seq>
+void run(const string& impl, int n)
+{
+    {
+        Seq s;
+        measure(impl, "append", n, n, [&s](long k) {
+            s.insert(s.size(), "item" + to_string(k));
+        });
+    }
+    Seq s;
+    build(s, n);
+    ItemType val;
+    vector<int> positions(n);
+    for(int i = 0; i < n; i++)
+        positions[i] = rand() % n;
+    measure(impl, "get_sequential", n, n, [&](long k) {
+        s.get(k, val);
+    });
+    auto&& r = reader(s);
+    measure(impl, "cursor_sequential", n, n, [&](long k) {
+        r.get(k, val);
+    });
+    measure(impl, "get_random", n, n, [&](long k) {
+        s.get(positions[k], val);
+    });
+    measure(impl, "set_random", n, n, [&](long k) {
+        s.set(positions[k], "set");
+    });
+    measure(impl, "find_missing", n, 100, [&](long) {
+        s.find("missing");
+    });
+    measure(impl, "insert_front", n, 1000, [&](long) {
+        s.insert(0, "front");
+    });
+    measure(impl, "erase_front", n, 1000, [&](long) {
+        s.erase(0);
+    });
+    // Nodes freed by an erase can be reused by the next insert
+    measure(impl, "churn", n, n, [&](long k) {
+        if(k % 2 == 0)
+            s.insert(0, "churn");
+        else
+            s.erase(0);
+    });
+    measure(impl, "copy", n, 10, [&](long) {
+        Seq t(s);
+    });
+}
+
+int main(int argc, char* argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    cout << "impl,workload,n,ops,ns_per_op,heap_allocs_per_op" << endl;
+    run<Sequence>("list", n);
+    run<ArraySequence>("array", n);
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+// Compares the linear-time subsequence with the two searches it replaced,
+// on a text of n single-letter items and patterns of m items:
+//   random      - random letters from a 4-letter alphabet, pattern absent
+//   worst_case  - text "aaa...a", pattern "aa...ab", which defeats a naive
+//                 search
+// Each call is repeated until the time limit; ms_per_call is the average.
+// Usage: benchSubsequence [n] [m]
+#include "Sequence.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+using namespace std;
+
+const double TIME_LIMIT = 1.0;  // seconds per measurement
+
+// The original version, which fetched every item by position
+int indexedSubsequence(const Sequence& seq1, const Sequence& seq2)
+{
+    int size1 = seq1.size(), size2 = seq2.size();
+    if(size1 == 0 || size2 == 0)
+        return -1;
+    int iter = 0;
+    ItemType val1, val2;
+    while(iter <= size1 - size2)
+    {
+        seq1.get(iter, val1);
+        seq2.get(0, val2);
+        if (val1 == val2)
+        {
+            int i = iter + 1, j = 1;
+            while(j < size2)
+            {
+                seq1.get(i, val1);
+                seq2.get(j, val2);
+                if(val1 != val2)
+                    break;
+                j++;
+                i++;
+            }
+            if(j == size2)
+                return iter;
+        }
+        iter++;
+    }
+    return -1;
+}
+
+// The iterator version, which tries every start position
+int naiveSubsequence(const Sequence& seq1, const Sequence& seq2)
+{
+    int size1 = seq1.size(), size2 = seq2.size();
+    if(size1 == 0 || size2 == 0)
+        return -1;
+    Sequence::const_iterator start = seq1.begin();
+    for(int pos = 0; pos <= size1 - size2; pos++, ++start)
+    {
+        Sequence::const_iterator i = start, j = seq2.begin();
+        while(j != seq2.end() && *i == *j)
+        {
+            ++i;
+            ++j;
+        }
+        if(j == seq2.end())
+            return pos;
+    }
+    return -1;
+}
+
+// Run search on text and pattern until the time limit, and print a CSV
+// record
+template <typename Search>
+void measure(const string& impl, const string& workload, const Sequence& text,
+             const Sequence& pattern, Search search)
+{
+    auto start = chrono::steady_clock::now();
+    long calls = 0;
+    double secs = 0;
+    int result = 0;
+    do
+    {
+        result = search(text, pattern);
+        calls++;
+        secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    } while(secs < TIME_LIMIT);
+    cout << impl << "," << workload << "," << text.size() << "," << pattern.size()
+         << "," << calls << "," << secs * 1e3 / calls << "," << result << endl;
+}
+
+void run(const string& workload, const Sequence& text, const Sequence& pattern)
+{
+    measure("indexed", workload, text, pattern, indexedSubsequence);
+    measure("naive", workload, text, pattern, naiveSubsequence);
+    measure("kmp", workload, text, pattern, subsequence);
+}
+
+int main(int argc, char* argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 20000;
+    int m = argc > 2 ? atoi(argv[2]) : 100;
+    cout << "impl,workload,n,m,calls,ms_per_call,result" << endl;
+
+    Sequence text, pattern;
+    for(int i = 0; i < n; i++)
+        text.insert(0, string(1, "abcd"[rand() % 4]));
+    for(int i = 0; i < m; i++)
+        pattern.insert(0, "e");
+    run("random", text, pattern);
+
+    Sequence same, almost;
+    for(int i = 0; i < n; i++)
+        same.insert(0, "a");
+    almost.insert(0, "b");
+    for(int i = 1; i < m; i++)
+        almost.insert(0, "a");
+    run("worst_case", same, almost);
+}
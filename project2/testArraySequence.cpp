@@ -0,0 +1,139 @@
+#include "ArraySequence.h"
+#include "Sequence.h"
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+using namespace std;
+
+// Check that a and s hold the same items in the same order
+void checkSame(const ArraySequence& a, const Sequence& s)
+{
+    assert(a.size() == s.size());
+    assert(a.empty() == s.empty());
+    ItemType x, y;
+    for(int i = 0; i < s.size(); i++)
+    {
+        assert(a.get(i, x) && s.get(i, y) && x == y);
+    }
+    assert(!a.get(s.size(), x));
+}
+
+void test()
+{
+    ArraySequence s;
+    assert(s.empty());
+    assert(s.insert(0, "lavash") == 0);
+    assert(s.insert(0, "tortilla") == 0);
+    assert(s.insert(5, "naan") == -1);
+    assert(s.size() == 2);
+    ItemType x = "injera";
+    assert(s.get(0, x)  &&  x == "tortilla");
+    assert(s.get(1, x)  &&  x == "lavash");
+    assert(s.insert("matzo") == 0);
+    assert(s.find("matzo") == 0);
+    assert(s.find("pita") == -1);
+    assert(!s.erase(3));
+    assert(s.erase(0));
+    assert(s.set(1, "tortilla"));
+    assert(s.remove("tortilla") == 2);
+    assert(s.empty());
+
+    // Inserting an item that's already in the sequence, across a regrowth
+    ArraySequence g;
+    for(int i = 0; i < 8; i++)
+        g.insert(i, "x" + to_string(i));
+    ItemType first;
+    g.get(0, first);
+    g.insert(g.size(), first);
+    assert(g.get(8, x) && x == "x0");
+
+    // Copy, assignment, swap
+    ArraySequence c(g);
+    c.erase(0);
+    assert(g.size() == 9 && c.size() == 8);
+    c = c;
+    assert(c.size() == 8);
+    g = c;
+    assert(g.size() == 8 && g.get(0, x) && x == "x1");
+    s.swap(g);
+    assert(s.size() == 8 && g.empty());
+
+    // Random operations give the same results as the linked-list Sequence
+    ArraySequence a;
+    Sequence l;
+    for(int step = 0; step < 5000; step++)
+    {
+        ItemType v = to_string(rand() % 20);
+        int pos = rand() % (l.size() + 2) - 1;
+        switch(rand() % 6)
+        {
+            case 0: assert(a.insert(pos, v) == l.insert(pos, v)); break;
+            case 1: assert(a.insert(v) == l.insert(v)); break;
+            case 2: assert(a.erase(pos) == l.erase(pos)); break;
+            case 3: assert(a.remove(v) == l.remove(v)); break;
+            case 4: assert(a.set(pos, v) == l.set(pos, v)); break;
+            case 5: assert(a.find(v) == l.find(v)); break;
+        }
+        checkSame(a, l);
+    }
+
+    // subsequence and interleave agree with the Sequence versions too
+    ArraySequence a1, a2;
+    Sequence l1, l2;
+    for(int i = 0; i < 30; i++)
+    {
+        ItemType v = to_string(rand() % 3);
+        a1.insert(i, v);
+        l1.insert(i, v);
+        if(i % 4 == 0)
+        {
+            a2.insert(a2.size(), v);
+            l2.insert(l2.size(), v);
+        }
+    }
+    for(int len = 0; len <= 3; len++)
+    {
+        ArraySequence ap;
+        Sequence lp;
+        for(int i = 0; i < len; i++)
+        {
+            a1.get(10 + i, x);
+            ap.insert(i, x);
+            lp.insert(i, x);
+        }
+        assert(subsequence(a1, ap) == subsequence(l1, lp));
+    }
+    // Patterns with many partial matches, or longer than the text
+    for(int trial = 0; trial < 2000; trial++)
+    {
+        ArraySequence at, ap;
+        Sequence lt, lp;
+        int n = rand() % 20, m = 1 + rand() % 6;
+        for(int i = 0; i < n; i++)
+        {
+            ItemType v = to_string(rand() % 2);
+            at.insert(i, v);
+            lt.insert(i, v);
+        }
+        for(int i = 0; i < m; i++)
+        {
+            ItemType v = to_string(rand() % 2);
+            ap.insert(i, v);
+            lp.insert(i, v);
+        }
+        assert(subsequence(at, ap) == subsequence(lt, lp));
+    }
+    interleave(a1, a2, a1);
+    interleave(l1, l2, l1);
+    checkSame(a1, l1);
+    ArraySequence empty;
+    interleave(empty, a2, empty);
+    assert(empty.size() == a2.size());
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "ConcurrentSequence.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+const int WRITERS = 4;
+const int READERS = 4;
+const int INSERTS_PER_WRITER = 3000;
+
+// An item that counts how many of it exist
+struct Counted
+{
+    static atomic<int> live;
+    int value;
+    Counted(int v = 0) : value(v) { live++; }
+    Counted(const Counted& other) : value(other.value) { live++; }
+    ~Counted() { live--; }
+    Counted& operator=(const Counted&) = default;
+};
+atomic<int> Counted::live(0);
+
+void test()
+{
+    // The basic operations, from one thread
+    ConcurrentSequence<string> c;
+    assert(c.empty()  &&  c.insert(0, "b") == 0  &&  c.insert("a") == 0);
+    assert(c.insert(5, "x") == -1);
+    assert(c.size() == 2  &&  c.find("b") == 1);
+    PersistentSequence<string> before = c.snapshot();
+    assert(c.set(0, "A")  &&  c.erase(1)  &&  c.remove("A") == 1  &&  c.empty());
+    assert(before.size() == 2);
+    int n = c.update([](PersistentSequence<string>& s) {
+        s.insert(0, "x");
+        s.insert(1, "y");
+        return s.size();
+    });
+    assert(n == 2  &&  c.size() == 2);
+    try
+    {
+        c.update([](PersistentSequence<string>& s) {
+            s.insert(0, "lost");
+            throw 1;
+        });
+        assert(false);
+    }
+    catch(int)
+    {
+    }
+    assert(c.size() == 2  &&  c.find("lost") == -1);
+
+    // A replaced version is freed by the next write if no reader holds
+    // it, so many writes don't pile up old versions
+    {
+        ConcurrentSequence<Counted> counted;
+        for(int i = 0; i < 100; i++)
+            counted.insert(i, Counted(i));
+        for(int i = 0; i < 1000; i++)
+            assert(counted.set(i % 100, Counted(i)));
+        assert(Counted::live == 100);
+        PersistentSequence<Counted> kept = counted.snapshot();
+        assert(counted.set(0, Counted(-1)));
+        assert(Counted::live > 100);
+        Counted first;
+        assert(kept.get(0, first)  &&  first.value == 900);
+    }
+    assert(Counted::live == 0);
+
+    // Writers insert in order and each remove some of their own items,
+    // while readers check every version they see is in order and that
+    // get agrees with iteration
+    ConcurrentSequence<int> s;
+    atomic<bool> done(false);
+    atomic<long> versionsChecked(0);
+    vector<thread> threads;
+    vector<int> removed(WRITERS, 0);
+    for(int w = 0; w < WRITERS; w++)
+        threads.emplace_back([&s, &removed, w]() {
+            for(int i = 0; i < INSERTS_PER_WRITER; i++)
+            {
+                s.insert(i * WRITERS + w);
+                if(i % 10 == 9)
+                    removed[w] += s.remove((i - 5) * WRITERS + w);
+            }
+        });
+    for(int r = 0; r < READERS; r++)
+        threads.emplace_back([&s, &done, &versionsChecked]() {
+            while(!done)
+            {
+                PersistentSequence<int> v = s.snapshot();
+                int prev = -1, count = 0;
+                for(int item : v)
+                {
+                    assert(item > prev);
+                    prev = item;
+                    count++;
+                }
+                assert(count == v.size());
+                if(count > 0)
+                {
+                    int x = -1;
+                    assert(v.get(count - 1, x)  &&  x == prev);
+                }
+                int size = s.size();
+                assert(size >= 0);
+                int y;
+                if(size > 0)
+                    s.get(size / 2, y);  // may have shrunk since, but mustn't crash
+                versionsChecked++;
+                this_thread::yield();
+            }
+        });
+    for(int w = 0; w < WRITERS; w++)
+        threads[w].join();
+    done = true;
+    for(int r = 0; r < READERS; r++)
+        threads[WRITERS + r].join();
+
+    int totalRemoved = 0;
+    for(int w = 0; w < WRITERS; w++)
+    {
+        assert(removed[w] == INSERTS_PER_WRITER / 10);
+        totalRemoved += removed[w];
+    }
+    assert(s.size() == WRITERS * INSERTS_PER_WRITER - totalRemoved);
+    assert(versionsChecked > 0);
+    PersistentSequence<int> final = s.snapshot();
+    int expected = 0;
+    for(int item : final)
+    {
+        // Skip the removed items
+        while((expected / WRITERS) % 10 == 4 && expected / WRITERS < INSERTS_PER_WRITER - 5)
+            expected++;
+        assert(item == expected);
+        expected++;
+    }
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
@@ -0,0 +1,82 @@
+#include "HashedString.h"
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+void test()
+{
+    // Equal exactly when the strings are, whatever their length
+    HashedString empty, a("a"), b = string("b");
+    assert(empty == HashedString("")  &&  empty.size() == 0);
+    assert(a == HashedString(string("a"))  &&  a != b  &&  a != empty);
+    assert(a <= b  &&  !(b <= a)  &&  a <= a);
+    for(int len = 0; len < 40; len++)
+    {
+        string s(len, 'x');
+        HashedString h(s);
+        assert(h.str() == s  &&  h == HashedString(s));
+        for(int i = 0; i < len; i++)
+        {
+            string t = s;
+            t[i] = 'y';
+            assert(h != HashedString(t));
+        }
+        assert(h != HashedString(s + '\0'));
+    }
+
+    // find, remove and subsequence give the same answers as for Sequence
+    Sequence plain;
+    HashedSequence hashed;
+    for(int i = 0; i < 2000; i++)
+    {
+        string key = "key-with-a-long-common-prefix-" + to_string(rand() % 300);
+        plain.insert(i, key);
+        hashed.insert(i, key);
+    }
+    for(int k = 0; k < 320; k++)
+    {
+        string key = "key-with-a-long-common-prefix-" + to_string(k);
+        assert(hashed.find(key) == plain.find(key));
+    }
+    Sequence plainPattern;
+    HashedSequence hashedPattern;
+    for(int i = 100; i < 103; i++)
+    {
+        string item;
+        plain.get(i, item);
+        plainPattern.insert(i - 100, item);
+        hashedPattern.insert(i - 100, item);
+    }
+    assert(subsequences(hashed, hashedPattern) == subsequences(plain, plainPattern));
+    assert(subsequences(hashed, hashedPattern, 1)[0] == subsequence(plain, plainPattern));
+    for(int k = 0; k < 320; k += 7)
+    {
+        string key = "key-with-a-long-common-prefix-" + to_string(k);
+        assert(hashed.remove(key) == plain.remove(key));
+    }
+    assert(hashed.size() == plain.size());
+    for(int i = 0; i < plain.size(); i++)
+    {
+        string item;
+        HashedString hitem;
+        plain.get(i, item);
+        hashed.get(i, hitem);
+        assert(hitem.str() == item);
+    }
+
+    // insert(value) keeps the strings' order
+    HashedSequence sorted;
+    sorted.insert("m");
+    sorted.insert("z");
+    sorted.insert("a");
+    assert(sorted.find("a") == 0  &&  sorted.find("m") == 1  &&  sorted.find("z") == 2);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
@@ -0,0 +1,90 @@
+#include "ArraySequence.h"
+#include "ThreadPool.h"
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+// Check the two sequences have the same items in the same order
+void checkSame(const ArraySequence& a, const ArraySequence& b)
+{
+    assert(a.size() == b.size());
+    ItemType x, y;
+    for(int i = 0; i < a.size(); i++)
+    {
+        assert(a.get(i, x)  &&  b.get(i, y));
+        assert(x == y);
+    }
+}
+
+void test()
+{
+    ThreadPool pool(4);
+
+    // Short sequences are handled too
+    ArraySequence small;
+    assert(small.parallel_find("a", pool) == -1);
+    assert(small.parallel_count("a", pool) == 0);
+    assert(small.parallel_remove("a", pool) == 0);
+    small.insert(0, "a");
+    small.insert(1, "b");
+    small.insert(2, "a");
+    assert(small.parallel_find("b", pool) == 1);
+    assert(small.parallel_count("a", pool) == 2);
+    assert(small.parallel_remove("a", pool) == 2  &&  small.size() == 1);
+
+    // Large ones give exactly what the serial scans do
+    for(int trial = 0; trial < 10; trial++)
+    {
+        int n = 100000 + rand() % 300000;
+        int kinds = 1 + rand() % 1000;
+        ArraySequence s;
+        s.reserve(n);
+        for(int i = 0; i < n; i++)
+            s.insert(i, "key" + to_string(rand() % kinds));
+        for(int probe = 0; probe < 5; probe++)
+        {
+            ItemType value = "key" + to_string(rand() % (kinds + 2));
+            assert(s.parallel_find(value, pool) == s.find(value));
+            ArraySequence serial(s), parallel(s);
+            int removed = serial.remove(value);
+            assert(parallel.parallel_count(value, pool) == removed);
+            assert(parallel.parallel_remove(value, pool) == removed);
+            checkSame(serial, parallel);
+        }
+        // A match only in the last chunk, and none at all
+        s.set(n - 1, "last");
+        assert(s.parallel_find("last", pool) == n - 1);
+        assert(s.parallel_find("nowhere", pool) == -1);
+
+        // Filtering keeps the survivors in order
+        auto keep = [](const ItemType& item) { return item.size() % 2 == 0; };
+        ArraySequence expected;
+        ItemType x;
+        for(int i = 0; i < s.size(); i++)
+        {
+            s.get(i, x);
+            if(keep(x))
+                expected.insert(expected.size(), x);
+        }
+        int removed = s.size() - expected.size();
+        assert(s.parallel_filter(keep, pool) == removed);
+        checkSame(expected, s);
+    }
+
+    // One thread works the same way
+    ThreadPool one(1);
+    ArraySequence s;
+    for(int i = 0; i < 100000; i++)
+        s.insert(i, i % 3 == 0 ? "x" : "y");
+    assert(s.parallel_count("x", one) == 33334);
+    assert(s.parallel_remove("y", one) == 66666);
+    assert(s.size() == 33334  &&  s.parallel_find("x", one) == 0);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
@@ -0,0 +1,139 @@
+#include "PersistentSequence.h"
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+// Counts how many items are alive, which is how many tree nodes are
+struct Counted
+{
+    static int alive;
+    int v;
+    Counted(int v = 0) : v(v) { alive++; }
+    Counted(const Counted& other) : v(other.v) { alive++; }
+    ~Counted() { alive--; }
+    Counted& operator=(const Counted& other) { v = other.v; return *this; }
+    bool operator==(const Counted& other) const { return v == other.v; }
+    bool operator<=(const Counted& other) const { return v <= other.v; }
+};
+int Counted::alive = 0;
+
+vector<int> items(const PersistentSequence<int>& s)
+{
+    return vector<int>(s.begin(), s.end());
+}
+
+void test()
+{
+    PersistentSequence<string> s;
+    assert(s.empty()  &&  s.begin() == s.end());
+    assert(s.insert(0, "b") == 0  &&  s.insert(0, "a") == 0  &&  s.insert(2, "d") == 2);
+    assert(s.insert(5, "x") == -1);
+    assert(s.insert("c") == 2  &&  s.insert("a") == 0);
+    string v;
+    assert(s.get(3, v)  &&  v == "c");
+    assert(s.find("d") == 4  &&  s.find("z") == -1);
+    PersistentSequence<string> old = s;
+    assert(s.remove("a") == 2  &&  s.size() == 3);
+    assert(s.set(0, "B")  &&  s.erase(2)  &&  ! s.erase(2));
+    assert(s.get(0, v)  &&  v == "B");
+    assert(old.size() == 5  &&  old.get(0, v)  &&  v == "a");
+
+    // Random edits agree with a vector, and every earlier version is left
+    // exactly as it was
+    PersistentSequence<int> p;
+    vector<int> ref;
+    vector<PersistentSequence<int>> versions;
+    vector<vector<int>> expected;
+    for(int step = 0; step < 20000; step++)
+    {
+        int n = ref.size();
+        int op = rand() % 6;
+        if(op < 3 || n == 0)
+        {
+            int pos = rand() % (n + 1);
+            assert(p.insert(pos, step % 50) == pos);
+            ref.insert(ref.begin() + pos, step % 50);
+        }
+        else if(op < 4)
+        {
+            int pos = rand() % n;
+            assert(p.erase(pos));
+            ref.erase(ref.begin() + pos);
+        }
+        else if(op < 5)
+        {
+            int pos = rand() % n;
+            assert(p.set(pos, -step));
+            ref[pos] = -step;
+            int x;
+            assert(p.get(pos, x)  &&  x == -step);
+        }
+        else if(rand() % 20 == 0)
+        {
+            int value = step % 50;
+            int removed = p.remove(value);
+            int count = 0;
+            for(int i = 0; i < (int) ref.size(); )
+            {
+                if(ref[i] == value)
+                {
+                    ref.erase(ref.begin() + i);
+                    count++;
+                }
+                else
+                    i++;
+            }
+            assert(removed == count);
+        }
+        assert(p.size() == (int) ref.size());
+        if(step % 500 == 0)
+        {
+            versions.push_back(p);
+            expected.push_back(ref);
+        }
+    }
+    assert(items(p) == ref);
+    for(size_t i = 0; i < versions.size(); i++)
+        assert(items(versions[i]) == expected[i]);
+
+    // Copies are O(1) and share everything; an edit only adds O(log n)
+    // nodes
+    {
+        PersistentSequence<Counted> big;
+        for(int i = 0; i < 10000; i++)
+            big.insert(i, Counted(i));
+        assert(Counted::alive == 10000);
+        vector<PersistentSequence<Counted>> snapshots;
+        for(int i = 0; i < 100; i++)
+        {
+            snapshots.push_back(big);
+            big.set(rand() % big.size(), Counted(-1));
+            big.erase(rand() % big.size());
+            big.insert(rand() % big.size(), Counted(-2));
+        }
+        assert(Counted::alive < 10000 + 100 * 3 * 60);
+        Counted c;
+        assert(snapshots[0].get(5000, c)  &&  c.v == 5000);
+        // Removing something that isn't there shares the whole tree
+        int before = Counted::alive;
+        assert(big.remove(Counted(123456)) == 0);
+        assert(Counted::alive == before);
+    }
+    assert(Counted::alive == 0);
+
+    // Large sequences stay fast
+    PersistentSequence<int> large;
+    for(int i = 0; i < 200000; i++)
+        large.insert(large.size() / 2, i);
+    int x;
+    assert(large.get(99999, x)  &&  x == 199999);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
@@ -0,0 +1,133 @@
+#include "Sequence.h"
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <thread>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+void test()
+{
+    // Positional operations in any order agree with a vector, however
+    // the finger has been left by earlier ones
+    BasicSequence<int> s;
+    vector<int> ref;
+    for(int step = 0; step < 100000; step++)
+    {
+        int n = ref.size();
+        int op = rand() % 8;
+        if(op < 3)
+        {
+            // Mostly near the last position used, sometimes anywhere
+            int pos = rand() % 4 == 0 ? rand() % (n + 1) : min(n, step % 7 + n / 2);
+            assert(s.insert(pos, step) == pos);
+            ref.insert(ref.begin() + pos, step);
+        }
+        else if(op < 5 && n > 0)
+        {
+            int pos = rand() % n;
+            assert(s.erase(pos));
+            ref.erase(ref.begin() + pos);
+        }
+        else if(op < 6 && n > 0)
+        {
+            int pos = rand() % n;
+            assert(s.set(pos, -step));
+            ref[pos] = -step;
+        }
+        else if(op < 7 && n > 0)
+        {
+            int pos = rand() % n;
+            int x = 0;
+            assert(s.get(pos, x)  &&  x == ref[pos]);
+        }
+        else if(n > 0)
+        {
+            int v = ref[rand() % n];
+            int removed = s.remove(v);
+            int expected = 0;
+            for(int i = 0; i < (int) ref.size(); )
+            {
+                if(ref[i] == v)
+                {
+                    ref.erase(ref.begin() + i);
+                    expected++;
+                }
+                else
+                    i++;
+            }
+            assert(removed == expected);
+        }
+        if(step % 5000 == 0)
+            assert(vector<int>(s.begin(), s.end()) == ref);
+    }
+    assert(vector<int>(s.begin(), s.end()) == ref);
+
+    // Splicing and swapping keep the finger right
+    BasicSequence<int> t;
+    int x = 0;
+    for(int i = 0; i < 10; i++)
+        t.insert(i, i);
+    assert(t.set(5, 5));
+    BasicSequence<int> front;
+    front.insert(0, -1);
+    front.insert(0, -2);
+    t.splice(0, front);
+    assert(t.get(6, x)  &&  x == 4);
+    assert(t.get(7, x)  &&  x == 5);
+    t.swap(s);
+    assert(s.get(7, x)  &&  x == 5);
+    assert(t.size() == (int) ref.size());
+    BasicSequence<int> moved(std::move(s));
+    assert(moved.get(8, x)  &&  x == 6);
+    assert(moved.erase(11)  &&  moved.get(10, x)  &&  x == 8);
+
+    // Walking a long sequence by position through a cursor, or appending
+    // to it, is linear
+    Sequence big;
+    for(int i = 0; i < 200000; i++)
+        assert(big.insert(big.size(), "item" + to_string(i)) == i);
+    string item;
+    Sequence::Cursor c = big.cursor();
+    for(int i = 0; i < big.size(); i++)
+        assert(c.get(i, item)  &&  item == "item" + to_string(i));
+    for(int i = big.size() - 1; i >= 0; i -= 2)
+        assert(c.get(i, item)  &&  item == "item" + to_string(i));
+    assert( ! c.get(-1, item)  &&  ! c.get(big.size(), item));
+    for(int i = big.size() - 1; i >= 0; i -= 2)
+        assert(big.erase(i));
+    assert(big.size() == 100000);
+
+    // Readers on several threads, each with its own cursor, share a
+    // sequence nobody is changing; get() leaves the sequence untouched
+    vector<thread> readers;
+    vector<long> sums(4, 0);
+    for(int t = 0; t < 4; t++)
+        readers.emplace_back([&big, &sums, t]() {
+            Sequence::Cursor mine = big.cursor();
+            string value;
+            for(int i = t; i < big.size(); i += 4)
+            {
+                assert(mine.get(i, value));
+                sums[t] += value.size();
+            }
+            for(int i = 0; i < 100; i++)
+                assert(big.get(big.size() / 2 + i, value));
+        });
+    for(thread& th : readers)
+        th.join();
+    long total = 0;
+    for(long sum : sums)
+        total += sum;
+    long expected = 0;
+    for(const string& v : big)
+        expected += v.size();
+    assert(total == expected);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
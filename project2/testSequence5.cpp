@@ -0,0 +1,90 @@
+#include "Sequence.h"
+#include <string>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+// Counts how often items are copied and moved
+struct Tracked
+{
+    static int copies;
+    static int moves;
+    string s;
+    Tracked(const string& s = "") : s(s) {}
+    Tracked(const char* a, const char* b) : s(string(a) + b) {}
+    Tracked(const Tracked& other) : s(other.s) { copies++; }
+    Tracked(Tracked&& other) noexcept : s(std::move(other.s)) { moves++; }
+    Tracked& operator=(const Tracked& other) { s = other.s; copies++; return *this; }
+    Tracked& operator=(Tracked&& other) noexcept { s = std::move(other.s); moves++; return *this; }
+    bool operator==(const Tracked& other) const { return s == other.s; }
+    bool operator<=(const Tracked& other) const { return s <= other.s; }
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+void test()
+{
+    BasicSequence<Tracked> s;
+    Tracked a("alpha");
+    Tracked::copies = Tracked::moves = 0;
+
+    // Inserting an lvalue copies it exactly once
+    assert(s.insert(0, a) == 0);
+    assert(Tracked::copies == 1  &&  Tracked::moves == 0);
+
+    // Inserting an rvalue moves it and never copies
+    assert(s.insert(1, Tracked("beta")) == 1);
+    assert(s.insert(Tracked("aardvark")) == 0);
+    assert(Tracked::copies == 1  &&  Tracked::moves == 2);
+
+    // Emplacing constructs in place: no copies or moves at all
+    assert(s.emplace(3, "gam", "ma") == 3);
+    assert(s.emplace(9, "bad", "pos") == -1);
+    assert(Tracked::copies == 1  &&  Tracked::moves == 2);
+    assert(s.size() == 4);
+    assert(s.find(Tracked("gamma")) == 3);
+    assert(s.find(Tracked("alpha")) == 1);
+
+    // Moving a sequence copies and moves no items, and leaves the source empty
+    Tracked::copies = Tracked::moves = 0;
+    BasicSequence<Tracked> t(std::move(s));
+    assert(t.size() == 4  &&  s.size() == 0  &&  s.empty());
+    BasicSequence<Tracked> u;
+    u.insert(0, Tracked("old"));
+    Tracked::copies = Tracked::moves = 0;
+    u = std::move(t);
+    assert(u.size() == 4  &&  t.empty());
+    assert(Tracked::copies == 0  &&  Tracked::moves == 0);
+    t = std::move(t);
+    assert(t.empty());
+
+    // A moved-from sequence is still usable
+    s.insert(0, Tracked("again"));
+    assert(s.size() == 1);
+
+    // Copying still copies each item once
+    BasicSequence<Tracked> v(u);
+    assert(Tracked::copies == 4  &&  v.size() == 4);
+
+    // Other item types work too
+    BasicSequence<int> ints;
+    assert(ints.insert(0, 10) == 0);
+    assert(ints.insert(5) == 0);
+    int x = 999;
+    assert(ints.get(1, x)  &&  x == 10);
+
+    // interleave still works with Sequence
+    Sequence s1, s2, r;
+    s1.insert(0, "a");
+    s1.insert(1, "c");
+    s2.insert(0, "b");
+    interleave(s1, s2, r);
+    string y;
+    assert(r.size() == 3  &&  r.get(1, y)  &&  y == "b");
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
\ No newline at end of file
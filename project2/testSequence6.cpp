@@ -0,0 +1,131 @@
+#include "Sequence.h"
+#include <string>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+// Counts how many items are alive
+struct Counted
+{
+    static int alive;
+    int v;
+    Counted(int v = 0) : v(v) { alive++; }
+    Counted(const Counted& other) : v(other.v) { alive++; }
+    ~Counted() { alive--; }
+    Counted& operator=(const Counted& other) { v = other.v; return *this; }
+    bool operator==(const Counted& other) const { return v == other.v; }
+    bool operator<=(const Counted& other) const { return v <= other.v; }
+};
+int Counted::alive = 0;
+
+void test()
+{
+    // A sequence makes its pool on first use
+    Sequence s;
+    assert(s.node_pool() == nullptr);
+    for(int i = 0; i < 1000; i++)
+        s.insert(i, "x");
+    const Sequence::Pool* p = s.node_pool();
+    assert(p != nullptr);
+    assert(p->node_allocations() == 1000);
+    assert(p->heap_allocations() < 20);
+
+    // Erased nodes are reused, so churn needs no more memory
+    long slabs = p->heap_allocations();
+    for(int i = 0; i < 10000; i++)
+    {
+        s.insert(0, "y");
+        s.erase(0);
+    }
+    assert(p->heap_allocations() == slabs);
+    assert(s.size() == 1000);
+
+    // A copy gets all of its nodes in one allocation
+    Sequence c(s);
+    assert(c.node_pool() != p);
+    assert(c.node_pool()->heap_allocations() == 1);
+    assert(c.size() == 1000  &&  c.find("x") == 0);
+
+    // Assignment releases the old nodes in bulk and reuses their memory
+    Sequence small;
+    small.insert(0, "a");
+    c = small;
+    assert(c.size() == 1  &&  c.find("a") == 0);
+    assert(c.node_pool()->heap_allocations() == 1);
+    c = s;
+    assert(c.size() == 1000);
+    assert(c.node_pool()->heap_allocations() == 1);
+
+    // Sequences can share one pool
+    Sequence::Pool shared;
+    {
+        Sequence a(shared), b(shared);
+        for(int i = 0; i < 100; i++)
+        {
+            a.insert(0, "a");
+            b.insert(0, "b");
+        }
+        assert(a.node_pool() == &shared  &&  b.node_pool() == &shared);
+        assert(shared.node_allocations() == 200);
+        a.remove("a");
+        for(int i = 0; i < 100; i++)
+            b.insert(0, "b");
+        assert(a.empty()  &&  b.size() == 200);
+        assert(b.find("a") == -1);
+
+        // Swapping with a sequence that owns its pool swaps the pools too
+        Sequence own;
+        own.insert(0, "own");
+        b.swap(own);
+        assert(own.node_pool() == &shared  &&  b.node_pool() != &shared);
+        assert(own.size() == 200  &&  b.size() == 1);
+        b.insert(0, "more");
+        assert(b.find("own") == 1);
+    }
+    long slabsNow = shared.heap_allocations();
+    {
+        // The memory the sequences gave back is reused
+        Sequence d(shared);
+        for(int i = 0; i < 200; i++)
+            d.insert(0, "d");
+    }
+    assert(shared.heap_allocations() == slabsNow);
+
+    // Moving a sequence takes its pool along with its nodes
+    Sequence m;
+    m.insert(0, "m");
+    const Sequence::Pool* mp = m.node_pool();
+    Sequence m2(std::move(m));
+    assert(m2.node_pool() == mp  &&  m.node_pool() == nullptr);
+    m.insert(0, "again");
+    assert(m.size() == 1  &&  m.node_pool() != mp);
+    m = std::move(m2);
+    assert(m.node_pool() == mp  &&  m.find("m") == 0);
+
+    // Items are destroyed however their nodes are released
+    {
+        BasicSequence<Counted> x;
+        BasicSequence<Counted>::Pool pool;
+        BasicSequence<Counted> y(pool);
+        for(int i = 0; i < 50; i++)
+        {
+            x.insert(i, Counted(i));
+            y.insert(Counted(i));
+        }
+        assert(Counted::alive == 100);
+        x.erase(3);
+        y.remove(Counted(7));
+        assert(Counted::alive == 98);
+        BasicSequence<Counted> z(x);
+        assert(Counted::alive == 147);
+        z = y;
+        assert(Counted::alive == 147);
+    }
+    assert(Counted::alive == 0);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
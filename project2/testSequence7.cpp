@@ -0,0 +1,107 @@
+#include "Sequence.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+// Build a sequence of the given items
+Sequence make(const vector<string>& items)
+{
+    Sequence s;
+    for(const string& item : items)
+        s.insert(s.size(), item);
+    return s;
+}
+
+vector<string> items(const Sequence& s)
+{
+    return vector<string>(s.begin(), s.end());
+}
+
+void test()
+{
+    // Range-for and iterators visit the items in order
+    Sequence s = make({ "a", "b", "c", "d" });
+    string all;
+    for(const string& item : s)
+        all += item;
+    assert(all == "abcd");
+    assert(distance(s.begin(), s.end()) == 4);
+    Sequence empty;
+    assert(empty.begin() == empty.end());
+    assert(empty.cbegin() == empty.cend());
+
+    // Going backwards from end() works too
+    Sequence::iterator it = s.end();
+    --it;
+    assert(*it == "d");
+    it--;
+    assert(*it-- == "c"  &&  *it == "b");
+    vector<string> back(make_reverse_iterator(s.end()), make_reverse_iterator(s.begin()));
+    assert(back == vector<string>({ "d", "c", "b", "a" }));
+
+    // Items can be changed through an iterator, but not a const_iterator
+    for(string& item : s)
+        item += "!";
+    assert(items(s) == vector<string>({ "a!", "b!", "c!", "d!" }));
+    *s.begin() = "z";
+    assert(s.find("z") == 0);
+    Sequence::const_iterator ci = s.begin();  // iterators convert
+    assert(ci == s.cbegin()  &&  ci->size() == 1);
+    assert(s.begin() == ci  &&  ci != s.end());
+
+    // Standard algorithms work
+    assert(find(s.begin(), s.end(), "c!") != s.end());
+    assert(count_if(s.cbegin(), s.cend(), [](const string& x) { return x.size() == 2; }) == 3);
+
+    // Other item types work too
+    BasicSequence<int> ints;
+    for(int i = 0; i < 5; i++)
+        ints.insert(i, i * i);
+    int sum = 0;
+    for(int v : ints)
+        sum += v;
+    assert(sum == 30);
+
+    // subsequence and interleave give the same answers as before
+    Sequence big = make({ "x", "y", "x", "y", "z", "x" });
+    assert(subsequence(big, make({ "x", "y", "z" })) == 2);
+    assert(subsequence(big, make({ "x" })) == 0);
+    assert(subsequence(big, make({ "z", "x" })) == 4);
+    assert(subsequence(big, make({ "x", "z" })) == -1);
+    assert(subsequence(big, make({ "x", "y", "z", "x", "y", "x", "y" })) == -1);
+    assert(subsequence(big, empty) == -1);
+    assert(subsequence(empty, big) == -1);
+    assert(subsequence(big, big) == 0);
+
+    Sequence r;
+    interleave(make({ "1", "3", "5", "7" }), make({ "2", "4" }), r);
+    assert(items(r) == vector<string>({ "1", "2", "3", "4", "5", "7" }));
+    interleave(make({ "1" }), make({ "2", "4", "6" }), r);
+    assert(items(r) == vector<string>({ "1", "2", "4", "6" }));
+    interleave(empty, make({ "2", "4" }), r);
+    assert(items(r) == vector<string>({ "2", "4" }));
+    interleave(empty, empty, r);
+    assert(r.empty());
+    Sequence t = make({ "a", "b" });
+    interleave(t, t, t);
+    assert(items(t) == vector<string>({ "a", "a", "b", "b" }));
+
+    // A long interleave takes linear time
+    Sequence long1, long2;
+    for(int i = 0; i < 200000; i++)
+    {
+        long1.insert(0, "x");
+        long2.insert(0, "y");
+    }
+    interleave(long1, long2, r);
+    assert(r.size() == 400000);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
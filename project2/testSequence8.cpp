@@ -0,0 +1,70 @@
+#include "Sequence.h"
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+// Build a sequence with one single-letter item per character of text
+Sequence make(const string& text)
+{
+    Sequence s;
+    for(char c : text)
+        s.insert(s.size(), string(1, c));
+    return s;
+}
+
+// All the places pattern occurs in text, found the obvious way
+vector<int> slowMatches(const string& text, const string& pattern)
+{
+    vector<int> result;
+    if(pattern.empty())
+        return result;
+    for(size_t p = 0; p + pattern.size() <= text.size(); p++)
+        if(text.compare(p, pattern.size(), pattern) == 0)
+            result.push_back(p);
+    return result;
+}
+
+void test()
+{
+    Sequence empty;
+    assert(subsequence(make("abcabd"), make("abd")) == 3);
+    assert(subsequence(make("aaaab"), make("aab")) == 2);
+    assert(subsequence(make("abc"), make("abcd")) == -1);
+    assert(subsequence(make("abc"), empty) == -1);
+    assert(subsequence(empty, make("a")) == -1);
+    assert(subsequences(make("aaaa"), make("aa")) == vector<int>({ 0, 1, 2 }));
+    assert(subsequences(make("abababa"), make("aba")) == vector<int>({ 0, 2, 4 }));
+    assert(subsequences(make("abc"), make("d")).empty());
+    assert(subsequences(empty, empty).empty());
+
+    // Agree with the obvious search on lots of small-alphabet cases, where
+    // partial matches are common
+    for(int trial = 0; trial < 3000; trial++)
+    {
+        string text, pattern;
+        int n = rand() % 40, m = 1 + rand() % 6;
+        for(int i = 0; i < n; i++)
+            text += char('a' + rand() % 2);
+        for(int i = 0; i < m; i++)
+            pattern += char('a' + rand() % 2);
+        vector<int> expected = slowMatches(text, pattern);
+        Sequence t = make(text), p = make(pattern);
+        assert(subsequences(t, p) == expected);
+        assert(subsequence(t, p) == (expected.empty() ? -1 : expected[0]));
+    }
+
+    // The worst case for a naive search is still fast
+    string text(200000, 'a'), pattern(1000, 'a');
+    pattern.back() = 'b';
+    text.back() = 'b';
+    assert(subsequence(make(text), make(pattern)) == 199000);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
@@ -0,0 +1,191 @@
+#include "Sequence.h"
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+// Total nodes and slabs the pools of the given sequences have handed out
+// and obtained; relinking nodes from one pool to another keeps the sum
+long allocations(const vector<const Sequence*>& seqs)
+{
+    long total = 0;
+    for(const Sequence* s : seqs)
+        if(s->node_pool() != nullptr)
+            total += s->node_pool()->node_allocations() + s->node_pool()->heap_allocations();
+    return total;
+}
+
+// Whether node is one of the nodes holding s's items
+bool holds(const Sequence& s, const string* node)
+{
+    for(const string& item : s)
+        if(&item == node)
+            return true;
+    return false;
+}
+
+Sequence make(const vector<string>& items)
+{
+    Sequence s;
+    s.append(items.begin(), items.end());
+    return s;
+}
+
+vector<string> items(const Sequence& s)
+{
+    return vector<string>(s.begin(), s.end());
+}
+
+// Check the links both ways
+void checkLinks(const Sequence& s)
+{
+    vector<string> forward = items(s);
+    vector<string> backward;
+    for(Sequence::const_iterator it = s.end(); it != s.begin(); )
+        backward.insert(backward.begin(), *--it);
+    assert(forward == backward  &&  (int) forward.size() == s.size());
+}
+
+void test()
+{
+    // Range append
+    Sequence s = make({ "a", "b" });
+    vector<string> more = { "c", "d" };
+    s.append(more.begin(), more.end());
+    s.append(more.begin(), more.begin());
+    assert(items(s) == vector<string>({ "a", "b", "c", "d" }));
+    checkLinks(s);
+    assert(s.insert(4, "e") == 4  &&  s.erase(0));
+    checkLinks(s);
+
+    // Splice at the front, middle and end
+    Sequence t = make({ "x", "y" });
+    assert(s.splice(2, t) == 2);
+    assert(t.empty()  &&  t.begin() == t.end());
+    assert(items(s) == vector<string>({ "b", "c", "x", "y", "d", "e" }));
+    checkLinks(s);
+    t = make({ "0" });
+    assert(s.splice(0, t) == 0);
+    t = make({ "9" });
+    assert(s.splice(s.size(), t) == 7);
+    assert(items(s) == vector<string>({ "0", "b", "c", "x", "y", "d", "e", "9" }));
+    checkLinks(s);
+    assert(s.splice(9, t) == -1  &&  s.splice(-1, t) == -1  &&  s.splice(0, s) == -1);
+    assert(s.splice(3, t) == 3  &&  s.size() == 8);
+    Sequence empty;
+    assert(empty.splice(0, s) == 0  &&  s.empty()  &&  empty.size() == 8);
+    checkLinks(empty);
+    t = make({ "q" });
+    t.splice(1, empty);
+    t.erase(8);
+    assert(items(t) == vector<string>({ "q", "0", "b", "c", "x", "y", "d", "e" }));
+    checkLinks(t);
+
+    // Relinking interleave, both ways round
+    Sequence a = make({ "1", "3", "5", "7" }), b = make({ "2", "4" });
+    a.interleave(b);
+    assert(items(a) == vector<string>({ "1", "2", "3", "4", "5", "7" }));
+    assert(b.empty());
+    checkLinks(a);
+    a = make({ "1" });
+    b = make({ "2", "4", "6" });
+    a.interleave(b);
+    assert(items(a) == vector<string>({ "1", "2", "4", "6" }));
+    checkLinks(a);
+    b.interleave(a);
+    assert(items(b) == vector<string>({ "1", "2", "4", "6" }));
+
+    // The free interleave still leaves its inputs alone, even as the result
+    Sequence r, c = make({ "a", "b" });
+    interleave(make({ "1", "3", "5", "7" }), make({ "2", "4" }), r);
+    assert(items(r) == vector<string>({ "1", "2", "3", "4", "5", "7" }));
+    interleave(c, c, c);
+    assert(items(c) == vector<string>({ "a", "a", "b", "b" }));
+
+    // Merge keeps things in order, with this sequence's items first
+    BasicSequence<int> m1, m2;
+    vector<int> v1 = { 1, 3, 3, 8 }, v2 = { 0, 3, 9, 10 };
+    m1.append(v1.begin(), v1.end());
+    m2.append(v2.begin(), v2.end());
+    m1.merge(m2);
+    assert(vector<int>(m1.begin(), m1.end()) == vector<int>({ 0, 1, 3, 3, 3, 8, 9, 10 }));
+    assert(m2.empty());
+    m2.merge(m1);
+    assert(m2.size() == 8  &&  m1.empty());
+    int last;
+    assert(m2.get(7, last)  &&  last == 10);
+    assert(m2.insert(11) == 8);
+
+    // Sequences sharing a pool relink without any allocation
+    Sequence::Pool pool;
+    Sequence p1(pool), p2(pool);
+    for(int i = 0; i < 1000; i++)
+    {
+        p1.insert(0, "p");
+        p2.insert(0, "q");
+    }
+    long before = allocations({ &p1, &p2 });
+    const string* q = &*p2.begin();
+    p1.interleave(p2);
+    assert(holds(p1, q)  &&  allocations({ &p1, &p2 }) == before);
+    for(int i = 0; i < 3; i++)
+        p2.insert(0, "r");
+    before = allocations({ &p1, &p2 });
+    q = &*p2.begin();
+    p1.splice(500, p2);
+    assert(holds(p1, q)  &&  allocations({ &p1, &p2 }) == before);
+    assert(p1.size() == 2003  &&  p1.find("q") == 1);
+
+    // So do sequences with pools of their own: one adopts the other's
+    Sequence o1, o2;
+    for(int i = 0; i < 1000; i++)
+    {
+        o1.insert(0, "o");
+        o2.insert(0, "n");
+    }
+    before = allocations({ &o1, &o2 });
+    const string* n = &*o2.begin();
+    o1.interleave(o2);
+    assert(holds(o1, n));
+    assert(allocations({ &o1, &o2 }) == before);
+    o2.insert(0, "still usable");
+    assert(o1.size() == 2000  &&  o2.size() == 1);
+    for(int i = 0; i < 2000; i += 2)
+        o1.erase(0);
+
+    // Items from a pool shared elsewhere are moved into new nodes
+    Sequence::Pool other;
+    Sequence p3(other);
+    p3.insert(0, "moved");
+    assert(p1.splice(0, p3) == 0);
+    assert(p3.empty()  &&  p1.find("moved") == 0);
+    checkLinks(p1);
+
+    // Even into a sequence with no pool yet, which mustn't start using a
+    // pool that can go away before it does
+    {
+        const string longString(100, 'x');
+        Sequence a, i1, m1;
+        {
+            Sequence::Pool p;
+            Sequence b(p), i2(p), m2(p);
+            b.insert(0, longString);
+            a.splice(0, b);
+            i2.insert(0, longString);
+            i1.interleave(i2);
+            m2.insert(0, longString);
+            m1.merge(m2);
+            assert(a.node_pool() != &p  &&  i1.node_pool() != &p  &&  m1.node_pool() != &p);
+        }
+        assert(a.find(longString) == 0  &&  i1.find(longString) == 0  &&  m1.find(longString) == 0);
+        a.insert(1, "more");
+        checkLinks(a);
+    }
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}
@@ -0,0 +1,112 @@
+#include "SortedSequence.h"
+#include "Sequence.h"
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <cassert>
+using namespace std;
+
+// Items that compare by key alone, so the tag shows where equal items went
+struct Keyed
+{
+    int key;
+    int tag;
+    Keyed(int key = 0, int tag = 0) : key(key), tag(tag) {}
+    bool operator==(const Keyed& other) const { return key == other.key; }
+    bool operator<=(const Keyed& other) const { return key <= other.key; }
+};
+
+// Check that s has exactly the same items as ref, in the same order
+void checkSame(const SortedSequence<Keyed>& s, const BasicSequence<Keyed>& ref)
+{
+    assert(s.size() == ref.size());
+    BasicSequence<Keyed>::const_iterator r = ref.begin();
+    for(const Keyed& k : s)
+    {
+        assert(k.key == r->key  &&  k.tag == r->tag);
+        ++r;
+    }
+    for(int pos = 0; pos < s.size(); pos += 1 + s.size() / 10)
+    {
+        Keyed a, b;
+        assert(s.get(pos, a)  &&  ref.get(pos, b));
+        assert(a.key == b.key  &&  a.tag == b.tag);
+    }
+}
+
+void test()
+{
+    SortedSequence<string> s;
+    assert(s.empty()  &&  s.find("a") == -1);
+    assert(s.insert("m") == 0);
+    assert(s.insert("c") == 0);
+    assert(s.insert("x") == 2);
+    assert(s.insert("m") == 1);
+    assert(s.size() == 4);
+    string v;
+    assert(s.get(3, v)  &&  v == "x");
+    assert( ! s.get(4, v)  &&  v == "x");
+    assert(s.find("m") == 1  &&  s.find("n") == -1);
+    assert(s.remove("m") == 2  &&  s.size() == 2);
+    assert(s.erase(1)  &&  ! s.erase(1));
+    assert(s.get(0, v)  &&  v == "c");
+
+    // Behaves exactly like a Sequence built with the ordered insert,
+    // including the order of equal items
+    SortedSequence<Keyed> sorted;
+    BasicSequence<Keyed> ref;
+    for(int step = 0; step < 20000; step++)
+    {
+        int key = rand() % 200;
+        int op = rand() % 10;
+        if(op < 6)
+        {
+            Keyed k(key, step);
+            assert(sorted.insert(k) == ref.insert(k));
+        }
+        else if(op < 7)
+            assert(sorted.remove(Keyed(key)) == ref.remove(Keyed(key)));
+        else if(op < 8)
+        {
+            int pos = ref.size() == 0 ? 0 : rand() % (ref.size() + 1);
+            assert(sorted.erase(pos) == ref.erase(pos));
+        }
+        else
+            assert(sorted.find(Keyed(key)) == ref.find(Keyed(key)));
+        if(step % 1000 == 0)
+            checkSame(sorted, ref);
+    }
+    checkSame(sorted, ref);
+
+    // Copies keep the order too, and are independent
+    SortedSequence<Keyed> copy(sorted);
+    checkSame(copy, ref);
+    copy.insert(Keyed(-1, 0));
+    assert(copy.size() == sorted.size() + 1);
+    SortedSequence<Keyed> assigned;
+    assigned = sorted;
+    checkSame(assigned, ref);
+    SortedSequence<Keyed> moved(std::move(assigned));
+    checkSame(moved, ref);
+    assert(assigned.empty()  &&  assigned.insert(Keyed(1)) == 0);
+    moved.swap(assigned);
+    assert(moved.size() == 1);
+    checkSame(assigned, ref);
+
+    // Large sequences stay fast
+    SortedSequence<int> big;
+    for(int i = 0; i < 200000; i++)
+        big.insert(int((i * 7919LL) % 200000));
+    int x;
+    assert(big.get(123456, x)  &&  x == 123456);
+    assert(big.find(199999) == 199999);
+    for(int i = 0; i < 200000; i += 2)
+        assert(big.remove(i) == 1);
+    assert(big.size() == 100000  &&  big.get(0, x)  &&  x == 1);
+}
+
+int main()
+{
+    test();
+    cout << "Passed all tests" << endl;
+}